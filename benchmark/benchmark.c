@@ -0,0 +1,576 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "osConfig.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "semaphore/semaphore.h"
+#include "mutex/mutex.h"
+#include "messageQueue/messageQueue.h"
+#include "timer/timer.h"
+#include "benchmark.h"
+
+#if defined(PLATFORM_POSIX)
+#include <time.h>
+#define BENCHMARK_TIME_UNIT "ns"
+#else
+#define BENCHMARK_TIME_UNIT "cycles"
+#endif
+
+#define BENCHMARK_WORKERS 4 // Number of benchmarked tasks
+
+/*Benchmarked tasks. Two tasks run at the same high priority, followed by one medium and one low priority task.*/
+#define WORKER_HIGH_A 0
+#define WORKER_HIGH_B 1
+#define WORKER_MEDIUM 2
+#define WORKER_LOW 3
+
+typedef void (*benchmarkFunctionType)();
+
+/*Benchmark and the function executed by each benchmarked task. Tasks without function do not take part.*/
+typedef struct
+{
+    const char *name;
+    benchmarkFunctionType workerFunction[BENCHMARK_WORKERS];
+} benchmarkType;
+
+TASK_DEFINE(benchmarkTask, 1024, benchmarkTaskFunction, NULL, BENCHMARK_TASK_PRIORITY);
+
+TASK_DEFINE(workerHighATask, 512, benchmarkWorkerFunction, (void *)WORKER_HIGH_A, BENCHMARK_TASK_PRIORITY + 1);
+TASK_DEFINE(workerHighBTask, 512, benchmarkWorkerFunction, (void *)WORKER_HIGH_B, BENCHMARK_TASK_PRIORITY + 1);
+TASK_DEFINE(workerMediumTask, 512, benchmarkWorkerFunction, (void *)WORKER_MEDIUM, BENCHMARK_TASK_PRIORITY + 2);
+TASK_DEFINE(workerLowTask, 512, benchmarkWorkerFunction, (void *)WORKER_LOW, BENCHMARK_TASK_PRIORITY + 3);
+
+SEMAPHORE_DEFINE(workerHighAStartSem, 0, 1);
+SEMAPHORE_DEFINE(workerHighBStartSem, 0, 1);
+SEMAPHORE_DEFINE(workerMediumStartSem, 0, 1);
+SEMAPHORE_DEFINE(workerLowStartSem, 0, 1);
+
+SEMAPHORE_DEFINE(benchmarkDoneSem, 0, 1);
+
+SEMAPHORE_DEFINE(preemptSem, 0, 1);
+SEMAPHORE_DEFINE(shuffleSem, 1, 1);
+SEMAPHORE_DEFINE(deadlockSem, 0, 1);
+SEMAPHORE_DEFINE(mediumSem, 0, 1);
+SEMAPHORE_DEFINE(irqSem, 0, 1);
+
+MUTEX_DEFINE(deadlockMutex);
+MUTEX_DEFINE(benchmarkMutex);
+
+MSG_QUEUE_DEFINE(benchmarkMsgQueue, 4, sizeof(uint32_t));
+
+TIMER_DEFINE(benchmarkTimer, benchmarkTimerHandler, TIMER_MODE_SINGLE_SHOT, NULL);
+
+static semaphoreHandleType *const workerStartSem[BENCHMARK_WORKERS] = {&workerHighAStartSem, &workerHighBStartSem,
+                                                                       &workerMediumStartSem, &workerLowStartSem};
+
+static const benchmarkType *pCurrentBenchmark = NULL; // Benchmark being executed by the benchmarked tasks
+
+static uint32_t activeWorkerCount = 0; // Number of tasks taking part in the current benchmark
+
+static uint32_t finishedWorkerCount = 0; // Number of tasks which have finished the current benchmark
+
+static uint32_t samples[BENCHMARK_SAMPLES];
+
+static uint32_t sampleCount = 0;
+
+static uint32_t timestampOverhead = 0; // Cost of reading the timestamp, subtracted from every sample
+
+static volatile uint32_t startTime; // Timestamp at the start of the measured interval
+
+static taskHandleType *volatile startTask = NULL; // Task which started the measured interval. NULL if not started.
+
+static volatile bool irqUnsupported = false;
+
+/**
+ * @brief Get current timestamp. On target, DWT cycle counter is used. It can be overridden on cores without DWT(ARMv6-M).
+ *
+ * @return Timestamp in BENCHMARK_TIME_UNIT
+ */
+__WEAK uint32_t benchmarkTimestamp()
+{
+#if defined(PLATFORM_POSIX)
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000 + now.tv_nsec);
+#elif defined(DWT)
+    return DWT->CYCCNT;
+#else
+    /*Cycle counter is not available. Use SysTick counter, which is accurate only for intervals shorter than a tick.*/
+    return SysTick->LOAD - SysTick->VAL;
+#endif
+}
+
+/**
+ * @brief Trigger the interrupt used by ISR to task latency benchmark. Application overrides this to pend an interrupt
+ * whose handler calls benchmarkIrqHandler, e.g. a spare NVIC interrupt pended with NVIC_SetPendingIRQ.
+ *
+ * @retval true if interrupt is triggered
+ * @retval false if not supported. ISR to task latency benchmark is skipped.
+ */
+__WEAK bool benchmarkIrqTrigger()
+{
+    return false;
+}
+
+/**
+ * @brief Called when all benchmarks have completed. It can be overridden, e.g. to exit the process on the POSIX port.
+ */
+__WEAK void benchmarkComplete()
+{
+}
+
+/**
+ * @brief Interrupt handler of ISR to task latency benchmark. Must be called from the interrupt triggered by
+ * benchmarkIrqTrigger.
+ */
+void benchmarkIrqHandler()
+{
+    semaphoreGive(&irqSem);
+}
+
+void benchmarkTimerHandler(void *context)
+{
+    (void)context;
+}
+
+/**
+ * @brief Record a sample, excluding the cost of reading the timestamp.
+ *
+ * @param elapsedTime Measured interval
+ */
+static void benchmarkSampleAdd(uint32_t elapsedTime)
+{
+    if (sampleCount < BENCHMARK_SAMPLES)
+    {
+        samples[sampleCount++] = (elapsedTime > timestampOverhead) ? elapsedTime - timestampOverhead : 0;
+    }
+}
+
+/**
+ * @brief Start the measured interval.
+ */
+static inline void benchmarkMarkStart()
+{
+    startTask = taskPool.currentTask;
+    startTime = benchmarkTimestamp();
+}
+
+/**
+ * @brief End the measured interval started by the running task and record it.
+ */
+static inline void benchmarkMarkEnd()
+{
+    uint32_t endTime = benchmarkTimestamp();
+
+    if (startTask != NULL)
+    {
+        startTask = NULL;
+        benchmarkSampleAdd(endTime - startTime);
+    }
+}
+
+/**
+ * @brief End the measured interval and record it, only if the interval was started by another task. Used for the
+ * intervals which must include a context switch.
+ */
+static inline void benchmarkMarkSwitchEnd()
+{
+    uint32_t endTime = benchmarkTimestamp();
+
+    if (startTask != NULL && startTask != taskPool.currentTask)
+    {
+        benchmarkSampleAdd(endTime - startTime);
+    }
+
+    startTask = NULL;
+}
+
+/**
+ * @brief Task switch time: two tasks of the same priority yield to each other. Time from one task calling taskYield
+ * to the other task resuming is measured.
+ */
+static void benchmarkTaskSwitch()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES / 2 + 1; i++)
+    {
+        benchmarkMarkStart();
+        taskYield();
+        benchmarkMarkSwitchEnd();
+    }
+}
+
+/**
+ * @brief Preemption time, high priority task side: wait to be woken by the low priority task.
+ */
+static void benchmarkPreemptionHigh()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        semaphoreTake(&preemptSem, TASK_MAX_WAIT);
+        benchmarkMarkSwitchEnd();
+    }
+}
+
+/**
+ * @brief Preemption time, low priority task side: wake the waiting high priority task, which preempts this task.
+ */
+static void benchmarkPreemptionLow()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        benchmarkMarkStart();
+        semaphoreGive(&preemptSem);
+    }
+}
+
+/**
+ * @brief Semaphore shuffle time: two tasks of the same priority pass a semaphore to each other. Time from one task
+ * giving the semaphore to the other task, waiting for it, taking it is measured.
+ */
+static void benchmarkSemaphoreShuffle()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES / 2 + 1; i++)
+    {
+        semaphoreTake(&shuffleSem, TASK_MAX_WAIT);
+        benchmarkMarkSwitchEnd();
+
+        /*Let the other task block on the semaphore*/
+        taskYield();
+
+        benchmarkMarkStart();
+        semaphoreGive(&shuffleSem);
+    }
+}
+
+/**
+ * @brief Deadlock break time, high priority task side: lock the mutex held by the low priority task. Time from
+ * calling mutexLock to acquiring the mutex is measured. With priority inheritance, the low priority task runs at high
+ * priority meanwhile and the ready medium priority task does not delay the high priority task.
+ */
+static void benchmarkDeadlockBreakHigh()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        semaphoreTake(&deadlockSem, TASK_MAX_WAIT);
+
+        benchmarkMarkStart();
+        mutexLock(&deadlockMutex, TASK_MAX_WAIT);
+        benchmarkMarkEnd();
+
+        mutexUnlock(&deadlockMutex);
+    }
+}
+
+/**
+ * @brief Deadlock break time, medium priority task side: become ready while the low priority task holds the mutex.
+ */
+static void benchmarkDeadlockBreakMedium()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        semaphoreTake(&mediumSem, TASK_MAX_WAIT);
+    }
+}
+
+/**
+ * @brief Deadlock break time, low priority task side: hold the mutex while the high priority task tries to lock it
+ * and the medium priority task becomes ready.
+ */
+static void benchmarkDeadlockBreakLow()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        mutexLock(&deadlockMutex, TASK_MAX_WAIT);
+
+        semaphoreGive(&deadlockSem);
+        semaphoreGive(&mediumSem);
+
+        mutexUnlock(&deadlockMutex);
+    }
+}
+
+/**
+ * @brief Message latency, receiver side: wait for messages from the low priority task.
+ */
+static void benchmarkMessageReceiver()
+{
+    uint32_t message;
+
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        msgQueueReceive(&benchmarkMsgQueue, &message, TASK_MAX_WAIT);
+        benchmarkMarkSwitchEnd();
+    }
+}
+
+/**
+ * @brief Message latency, sender side: send a message to the waiting high priority task.
+ */
+static void benchmarkMessageSender()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        benchmarkMarkStart();
+        msgQueueSend(&benchmarkMsgQueue, &i, TASK_MAX_WAIT);
+    }
+}
+
+/**
+ * @brief ISR to task latency, task side: wait for the semaphore given from the interrupt handler.
+ */
+static void benchmarkIrqHigh()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        semaphoreTake(&irqSem, TASK_MAX_WAIT);
+
+        if (irqUnsupported)
+        {
+            break;
+        }
+
+        benchmarkMarkSwitchEnd();
+    }
+}
+
+/**
+ * @brief ISR to task latency, interrupted task side: trigger the interrupt. Time from triggering the interrupt to the
+ * woken task resuming is measured.
+ */
+static void benchmarkIrqLow()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        benchmarkMarkStart();
+
+        if (!benchmarkIrqTrigger())
+        {
+            irqUnsupported = true;
+            semaphoreGive(&irqSem);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Uncontended mutex lock and unlock.
+ */
+static void benchmarkMutexUncontended()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        benchmarkMarkStart();
+        mutexLock(&benchmarkMutex, TASK_NO_WAIT);
+        mutexUnlock(&benchmarkMutex);
+        benchmarkMarkEnd();
+    }
+}
+
+/**
+ * @brief Start and stop of a software timer.
+ */
+static void benchmarkTimerStartStop()
+{
+    for (uint32_t i = 0; i < BENCHMARK_SAMPLES; i++)
+    {
+        benchmarkMarkStart();
+        timerStart(&benchmarkTimer, 1000);
+        timerStop(&benchmarkTimer);
+        benchmarkMarkEnd();
+    }
+}
+
+static const benchmarkType benchmarks[] = {
+    {"task switch", {[WORKER_HIGH_A] = benchmarkTaskSwitch, [WORKER_HIGH_B] = benchmarkTaskSwitch}},
+    {"preemption", {[WORKER_HIGH_A] = benchmarkPreemptionHigh, [WORKER_LOW] = benchmarkPreemptionLow}},
+    {"semaphore shuffle", {[WORKER_HIGH_A] = benchmarkSemaphoreShuffle, [WORKER_HIGH_B] = benchmarkSemaphoreShuffle}},
+#if (MUTEX_USE_PRIORITY_INHERITANCE)
+    {"deadlock break(inheritance)",
+#else
+    {"deadlock break(no inheritance)",
+#endif
+     {[WORKER_HIGH_A] = benchmarkDeadlockBreakHigh, [WORKER_MEDIUM] = benchmarkDeadlockBreakMedium,
+      [WORKER_LOW] = benchmarkDeadlockBreakLow}},
+    {"message latency", {[WORKER_HIGH_A] = benchmarkMessageReceiver, [WORKER_LOW] = benchmarkMessageSender}},
+    {"ISR to task latency", {[WORKER_HIGH_A] = benchmarkIrqHigh, [WORKER_LOW] = benchmarkIrqLow}},
+    {"mutex lock/unlock uncontended", {[WORKER_HIGH_A] = benchmarkMutexUncontended}},
+    {"timer start/stop", {[WORKER_HIGH_A] = benchmarkTimerStartStop}},
+};
+
+/**
+ * @brief Entry function of the benchmarked tasks. Each task waits to be started, executes its function of the current
+ * benchmark and signals the benchmark task once all tasks taking part have finished.
+ *
+ * @param params Index of the benchmarked task
+ */
+void benchmarkWorkerFunction(void *params)
+{
+    uint32_t index = (uint32_t)(uintptr_t)params;
+
+    while (1)
+    {
+        semaphoreTake(workerStartSem[index], TASK_MAX_WAIT);
+
+        pCurrentBenchmark->workerFunction[index]();
+
+        ENTER_CRITICAL_SECTION();
+
+        bool allFinished = (++finishedWorkerCount == activeWorkerCount);
+
+        EXIT_CRITICAL_SECTION();
+
+        if (allFinished)
+        {
+            semaphoreGive(&benchmarkDoneSem);
+        }
+    }
+}
+
+static int benchmarkSampleCompare(const void *pA, const void *pB)
+{
+    uint32_t a = *(const uint32_t *)pA;
+    uint32_t b = *(const uint32_t *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Report minimum, average, percentiles and maximum of the recorded samples.
+ *
+ * @param name Name of the benchmark
+ */
+static void benchmarkReport(const char *name)
+{
+    if (sampleCount == 0)
+    {
+        printf("%-32s %s\n", name, "not supported");
+        return;
+    }
+
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < sampleCount; i++)
+    {
+        sum += samples[i];
+    }
+
+    qsort(samples, sampleCount, sizeof(samples[0]), benchmarkSampleCompare);
+
+    printf("%-32s %8lu %8lu %8lu %8lu %8lu %8lu\n", name, (unsigned long)samples[0],
+           (unsigned long)(sum / sampleCount), (unsigned long)samples[(sampleCount - 1) * 50 / 100],
+           (unsigned long)samples[(sampleCount - 1) * 90 / 100], (unsigned long)samples[(sampleCount - 1) * 99 / 100],
+           (unsigned long)samples[sampleCount - 1]);
+}
+
+/**
+ * @brief Run a benchmark on the benchmarked tasks and wait until all of them have finished.
+ *
+ * @param pBenchmark Pointer to the benchmark
+ */
+static void benchmarkRun(const benchmarkType *pBenchmark)
+{
+    pCurrentBenchmark = pBenchmark;
+    sampleCount = 0;
+    startTask = NULL;
+    finishedWorkerCount = 0;
+    activeWorkerCount = 0;
+
+    for (uint32_t i = 0; i < BENCHMARK_WORKERS; i++)
+    {
+        if (pBenchmark->workerFunction[i] != NULL)
+        {
+            activeWorkerCount++;
+        }
+    }
+
+    /*Benchmarked tasks have lower priority; hence, they start once the benchmark task waits*/
+    for (uint32_t i = 0; i < BENCHMARK_WORKERS; i++)
+    {
+        if (pBenchmark->workerFunction[i] != NULL)
+        {
+            semaphoreGive(workerStartSem[i]);
+        }
+    }
+
+    semaphoreTake(&benchmarkDoneSem, TASK_MAX_WAIT);
+
+    benchmarkReport(pBenchmark->name);
+}
+
+void benchmarkTaskFunction(void *params)
+{
+    (void)params;
+
+#if !defined(PLATFORM_POSIX) && defined(DWT)
+    /*Enable DWT cycle counter*/
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    /*Minimum cost of reading the timestamp*/
+    timestampOverhead = UINT32_MAX;
+
+    for (uint32_t i = 0; i < 100; i++)
+    {
+        uint32_t start = benchmarkTimestamp();
+        uint32_t overhead = benchmarkTimestamp() - start;
+
+        if (overhead < timestampOverhead)
+        {
+            timestampOverhead = overhead;
+        }
+    }
+
+    printf("sanoRTOS kernel benchmark, %u samples, time in %s\n", (unsigned)BENCHMARK_SAMPLES, BENCHMARK_TIME_UNIT);
+    printf("%-32s %8s %8s %8s %8s %8s %8s\n", "", "min", "avg", "p50", "p90", "p99", "max");
+
+    for (uint32_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++)
+    {
+        benchmarkRun(&benchmarks[i]);
+    }
+
+    benchmarkComplete();
+
+    taskSuspend(taskPool.currentTask);
+}
+
+/**
+ * @brief Start the benchmark task and the benchmarked tasks. Benchmarks run once the scheduler is started.
+ */
+void benchmarkStart()
+{
+    taskStart(&benchmarkTask);
+    taskStart(&workerHighATask);
+    taskStart(&workerHighBTask);
+    taskStart(&workerMediumTask);
+    taskStart(&workerLowTask);
+}
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_BENCHMARK_H
+#define __SANO_RTOS_BENCHMARK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*Rhealstone style kernel latency benchmark. Each benchmark records BENCHMARK_SAMPLES latency samples and reports their
+ minimum, average, percentiles and maximum. Samples are in DWT cycles on target and in nanoseconds on the POSIX port,
+ and exclude the overhead of reading the timestamp.*/
+
+#define BENCHMARK_SAMPLES 1000 // Number of samples recorded by each benchmark
+
+#define BENCHMARK_TASK_PRIORITY 1 // Priority of the benchmark control task. Benchmarked tasks run at the next 3 lower priorities.
+
+    uint32_t benchmarkTimestamp();
+
+    bool benchmarkIrqTrigger();
+
+    void benchmarkIrqHandler();
+
+    void benchmarkStart();
+
+    void benchmarkComplete();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdlib.h>
 #include <assert.h>
 #include "osConfig.h"
@@ -48,16 +49,36 @@ int condVarWait(condVarHandleType *pCondVar, uint32_t waitTicks)
 
     int retCode;
 
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    ENTER_CRITICAL_SECTION();
+
+    currentTask->wakeupReason = WAKEUP_REASON_NONE;
+
+    /*Task is added to the waitQueue before unlocking the mutex; hence, a signal sent as soon as the mutex is unlocked
+    is not missed.*/
+    taskQueueAdd(&pCondVar->waitQueue, &currentTask->waitNode);
+
+    EXIT_CRITICAL_SECTION();
+
     /* Unlock previously acquired mutex;*/
     mutexUnlock(pCondVar->pMutex);
 
-    taskHandleType *currentTask = taskPool.currentTask;
+    ENTER_CRITICAL_SECTION();
 
 wait:
-    taskQueueAdd(&pCondVar->waitQueue, currentTask);
+    /*Task is no longer in the waitQueue if the condition variable has been signalled meanwhile*/
+    if (currentTask->waitNode.pTaskQueue == &pCondVar->waitQueue)
+    {
+        taskBlockUnlocked(currentTask, WAIT_FOR_COND_VAR, waitTicks);
 
-    /* Block current task and give CPU to other tasks while waiting on condition variable*/
-    taskBlock(currentTask, WAIT_FOR_COND_VAR, waitTicks);
+        EXIT_CRITICAL_SECTION();
+
+        /* Give CPU to other tasks while waiting on condition variable*/
+        taskYield();
+
+        ENTER_CRITICAL_SECTION();
+    }
 
     /*Task has been woken up either due to wait timeout or by another task by signalling the condtion variable.*/
     if (currentTask->wakeupReason == COND_VAR_SIGNALLED)
@@ -67,7 +88,7 @@ wait:
     else if (currentTask->wakeupReason == WAIT_TIMEOUT)
     {
         /*Wait timed out,remove task from  the waitQueue.*/
-        taskQueueRemove(&pCondVar->waitQueue, currentTask);
+        taskQueueRemove(&pCondVar->waitQueue, &currentTask->waitNode);
 
         retCode = RET_TIMEOUT;
     }
@@ -75,9 +96,18 @@ wait:
       In this case, retry waiting on condition variable again */
     else
     {
+        /*Remove task from the waitQueue(if still there) before waiting again, as its queue node will be re-used.*/
+        taskQueueRemove(&pCondVar->waitQueue, &currentTask->waitNode);
+
+        currentTask->wakeupReason = WAKEUP_REASON_NONE;
+
+        taskQueueAdd(&pCondVar->waitQueue, &currentTask->waitNode);
+
         goto wait;
     }
 
+    EXIT_CRITICAL_SECTION();
+
     /*Re-acquire previously released mutex*/
     mutexLock(pCondVar->pMutex, TASK_MAX_WAIT);
 
@@ -97,6 +127,12 @@ int condVarSignal(condVarHandleType *pCondVar)
 
     taskHandleType *nextSignalTask = NULL;
 
+    int retCode = RET_NOTASK;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
     /*Get next highest priority waiting task to unblock*/
 getNextSignalTask:
     nextSignalTask = taskQueueGet(&pCondVar->waitQueue);
@@ -114,12 +150,20 @@ getNextSignalTask:
          *higher priority[lower priority value] than that of current task */
         if (nextSignalTask->priority <= taskPool.currentTask->priority)
         {
-            taskYield();
+            contextSwitchRequired = true;
         }
-        return RET_SUCCESS;
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
     }
 
-    return RET_NOTASK;
+    return retCode;
 }
 
 /**
@@ -133,6 +177,10 @@ int condVarBroadcast(condVarHandleType *pCondVar)
 {
     assert(pCondVar != NULL);
 
+    int retCode = RET_NOTASK;
+
+    ENTER_CRITICAL_SECTION();
+
     if (!taskQueueEmpty(&pCondVar->waitQueue))
     {
         taskHandleType *pTask = NULL;
@@ -145,7 +193,10 @@ int condVarBroadcast(condVarHandleType *pCondVar)
             }
         }
 
-        return RET_SUCCESS;
+        retCode = RET_SUCCESS;
     }
-    return RET_NOTASK;
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
 }
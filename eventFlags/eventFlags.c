@@ -0,0 +1,242 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "taskQueue/taskQueue.h"
+#include "eventFlags.h"
+
+/*Bits of eventFlagsOptions of a waiting task*/
+#define EVENT_FLAGS_OPTION_WAIT_ALL 0x01
+#define EVENT_FLAGS_OPTION_CLEAR_ON_EXIT 0x02
+
+/**
+ * @brief Check if the flags satisfy a wait
+ *
+ * @param flags Flag word
+ * @param mask Flags awaited
+ * @param waitAll true if all the flags of the mask are awaited, false if any of them is awaited
+ * @retval true if the wait is satisfied
+ * @retval false, otherwise
+ */
+static inline bool eventFlagsSatisfied(uint32_t flags, uint32_t mask, bool waitAll)
+{
+    return waitAll ? ((flags & mask) == mask) : ((flags & mask) != 0);
+}
+
+/**
+ * @brief Wait for any or all of the specified flags of an event flags object to be set. If calling this function from
+ * an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ * @param pEventFlags Pointer to the eventFlagsHandle struct
+ * @param mask Flags to wait for. Must be non-zero.
+ * @param waitMode EVENT_FLAGS_WAIT_ANY or EVENT_FLAGS_WAIT_ALL
+ * @param clearOnExit Clear the flags of the mask when the wait is satisfied
+ * @param pFlags Pointer to the variable to be assigned the flag word that satisfied the wait, before clearing. Can be
+ * NULL.
+ * @param waitTicks Number of ticks to wait if the wait is not satisfied
+ * @retval RET_SUCCESS if the wait is satisfied
+ * @retval RET_BUSY if the wait is not satisfied and waitTicks is TASK_NO_WAIT
+ * @retval RET_TIMEOUT if timeout occured while waiting for the flags
+ * @retval RET_INVAL if mask is 0
+ */
+int eventFlagsWait(eventFlagsHandleType *pEventFlags, uint32_t mask, eventFlagsWaitModeType waitMode, bool clearOnExit,
+                   uint32_t *pFlags, uint32_t waitTicks)
+{
+    assert(pEventFlags != NULL);
+
+    if (mask == 0)
+    {
+        return RET_INVAL;
+    }
+
+    bool waitAll = (waitMode == EVENT_FLAGS_WAIT_ALL);
+
+    uint32_t flags = 0;
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (eventFlagsSatisfied(pEventFlags->flags, mask, waitAll))
+    {
+        flags = pEventFlags->flags;
+
+        if (clearOnExit)
+        {
+            pEventFlags->flags &= ~mask;
+        }
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_BUSY;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        /*Record the wait in the task, to be evaluated by eventFlagsSet*/
+        currentTask->eventFlags = mask;
+        currentTask->eventFlagsOptions = (waitAll ? EVENT_FLAGS_OPTION_WAIT_ALL : 0) |
+                                         (clearOnExit ? EVENT_FLAGS_OPTION_CLEAR_ON_EXIT : 0);
+
+        taskQueueAdd(&pEventFlags->waitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that the flags cannot be set before the task is blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_EVENT_FLAGS, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        /*Give CPU to other tasks while waiting for the flags*/
+        taskYield();
+
+        /*Re-enter critical section after being unblocked*/
+        ENTER_CRITICAL_SECTION();
+
+        if (currentTask->wakeupReason == EVENT_FLAGS_SET)
+        {
+            /*Task was removed from the waitQueue and flags were cleared by eventFlagsSet*/
+            flags = currentTask->eventFlags;
+
+            retCode = RET_SUCCESS;
+        }
+        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            /*Wait timed out,remove task from the waitQueue.*/
+            taskQueueRemove(&pEventFlags->waitQueue, &currentTask->waitNode);
+
+            retCode = RET_TIMEOUT;
+        }
+        /*Task might have been suspended while waiting for the flags and later resumed.
+          In this case, check the flags again */
+        else
+        {
+            /*Remove task from the waitQueue(if still there) before retrying, as its queue node will be re-used.*/
+            taskQueueRemove(&pEventFlags->waitQueue, &currentTask->waitNode);
+
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (pFlags != NULL)
+    {
+        *pFlags = flags;
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Set flags of an event flags object. All waiting tasks are evaluated against the new flag word in a single
+ * pass, and every task whose wait is satisfied is made ready. Flags to be cleared on exit by the woken tasks are
+ * cleared after the pass, so that tasks waiting for the same flags are all woken. Can be called from an ISR.
+ * @param pEventFlags Pointer to the eventFlagsHandle struct
+ * @param mask Flags to set
+ * @retval RET_SUCCESS
+ */
+int eventFlagsSet(eventFlagsHandleType *pEventFlags, uint32_t mask)
+{
+    assert(pEventFlags != NULL);
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    uint32_t flags = pEventFlags->flags | mask;
+
+    uint32_t clearMask = 0;
+
+    taskNodeType *pTaskNode = pEventFlags->waitQueue.head;
+
+    while (pTaskNode != NULL)
+    {
+        taskNodeType *nextTaskNode = pTaskNode->nextTaskNode;
+
+        taskHandleType *pTask = pTaskNode->pTask;
+
+        /*A task suspended while waiting is left in the waitQueue; it checks the flags again when resumed.*/
+        if (pTask->status != TASK_STATUS_SUSPENDED &&
+            eventFlagsSatisfied(flags, pTask->eventFlags, pTask->eventFlagsOptions & EVENT_FLAGS_OPTION_WAIT_ALL))
+        {
+            if (pTask->eventFlagsOptions & EVENT_FLAGS_OPTION_CLEAR_ON_EXIT)
+            {
+                clearMask |= pTask->eventFlags;
+            }
+
+            pTask->eventFlags = flags;
+
+            taskQueueRemove(&pEventFlags->waitQueue, pTaskNode);
+
+            taskSetReady(pTask, EVENT_FLAGS_SET);
+
+            /*Perform context switch if unblocked task has equal or
+             *higher priority[lower priority value] than that of current task */
+            if (pTask->priority <= taskPool.currentTask->priority)
+            {
+                contextSwitchRequired = true;
+            }
+        }
+
+        pTaskNode = nextTaskNode;
+    }
+
+    pEventFlags->flags = flags & ~clearMask;
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Clear flags of an event flags object. Can be called from an ISR.
+ * @param pEventFlags Pointer to the eventFlagsHandle struct
+ * @param mask Flags to clear
+ * @return Flag word before clearing
+ */
+uint32_t eventFlagsClear(eventFlagsHandleType *pEventFlags, uint32_t mask)
+{
+    assert(pEventFlags != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    uint32_t flags = pEventFlags->flags;
+
+    pEventFlags->flags = flags & ~mask;
+
+    EXIT_CRITICAL_SECTION();
+
+    return flags;
+}
@@ -0,0 +1,82 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_EVENT_FLAGS_H
+#define __SANO_RTOS_EVENT_FLAGS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Statically define and initialize an event flags object.
+ * @param name Name of the event flags object.
+ * @param initial_flags Initial value of the 32-bit flag word.
+ */
+#define EVENT_FLAGS_DEFINE(name, initial_flags) \
+    eventFlagsHandleType name = {               \
+        .waitQueue = {0},                       \
+        .flags = initial_flags}
+
+    typedef enum
+    {
+        EVENT_FLAGS_WAIT_ANY, // Wait until any of the flags of the mask is set
+        EVENT_FLAGS_WAIT_ALL  // Wait until all the flags of the mask are set
+    } eventFlagsWaitModeType;
+
+    typedef struct
+    {
+        taskQueueType waitQueue;
+        volatile uint32_t flags;
+    } eventFlagsHandleType;
+
+    int eventFlagsWait(eventFlagsHandleType *pEventFlags, uint32_t mask, eventFlagsWaitModeType waitMode, bool clearOnExit,
+                       uint32_t *pFlags, uint32_t waitTicks);
+
+    int eventFlagsSet(eventFlagsHandleType *pEventFlags, uint32_t mask);
+
+    uint32_t eventFlagsClear(eventFlagsHandleType *pEventFlags, uint32_t mask);
+
+    /**
+     * @brief Get the current value of the flag word of an event flags object
+     *
+     * @param pEventFlags Pointer to the eventFlagsHandle struct
+     * @return Flag word
+     */
+    static inline uint32_t eventFlagsGet(eventFlagsHandleType *pEventFlags)
+    {
+        return pEventFlags->flags;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,680 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "osConfig.h"
+#include "scheduler/scheduler.h"
+#include "heap.h"
+
+#define HEAP_BLOCK_FREE 0x1UL      // Block is free
+#define HEAP_BLOCK_PREV_FREE 0x2UL // Block just before this block in memory is free
+#define HEAP_BLOCK_FLAGS (HEAP_BLOCK_FREE | HEAP_BLOCK_PREV_FREE)
+
+#define HEAP_BLOCK_HEADER_SIZE offsetof(heapBlockType, nextFreeBlock)          // Overhead of an allocated block. Two words, a multiple of HEAP_ALIGN_SIZE.
+#define HEAP_BLOCK_MIN_SIZE (sizeof(heapBlockType) - HEAP_BLOCK_HEADER_SIZE)   // A free block must hold its links
+#define HEAP_BLOCK_MAX_SIZE ((1UL << OS_HEAP_MAX_SIZE_LOG2) - HEAP_ALIGN_SIZE) // Largest size mapped to a free list
+#define HEAP_SMALL_BLOCK_SIZE (1UL << HEAP_FL_INDEX_SHIFT)                     // Sizes below this map to the first class
+
+#if (OS_HEAP_NEWLIB) && !defined(PLATFORM_POSIX)
+HEAP_DEFINE(newlibHeap, OS_HEAP_NEWLIB_SIZE);
+#endif
+
+/**
+ * @brief Get index of the most significant set bit of a non-zero value
+ */
+static inline uint32_t heapFls(uint32_t value)
+{
+    return 31 - __builtin_clz(value);
+}
+
+/**
+ * @brief Get index of the least significant set bit of a non-zero value
+ */
+static inline uint32_t heapFfs(uint32_t value)
+{
+    return __builtin_ctz(value);
+}
+
+static inline size_t heapBlockSize(heapBlockType *pBlock)
+{
+    return pBlock->size & ~HEAP_BLOCK_FLAGS;
+}
+
+static inline void heapBlockSizeSet(heapBlockType *pBlock, size_t size)
+{
+    pBlock->size = size | (pBlock->size & HEAP_BLOCK_FLAGS);
+}
+
+static inline heapBlockType *heapBlockFromPtr(void *ptr)
+{
+    return (heapBlockType *)((uint8_t *)ptr - HEAP_BLOCK_HEADER_SIZE);
+}
+
+static inline void *heapBlockToPtr(heapBlockType *pBlock)
+{
+    return (uint8_t *)pBlock + HEAP_BLOCK_HEADER_SIZE;
+}
+
+/**
+ * @brief Get the block just after a block in memory. The last block of a heap is followed by a zero sized sentinel
+ * block, which is never free.
+ */
+static inline heapBlockType *heapBlockNext(heapBlockType *pBlock)
+{
+    return (heapBlockType *)((uint8_t *)heapBlockToPtr(pBlock) + heapBlockSize(pBlock));
+}
+
+/**
+ * @brief Mark a block free or used, and update HEAP_BLOCK_PREV_FREE flag and prevPhysBlock of the block after it
+ */
+static inline void heapBlockMarkFree(heapBlockType *pBlock, bool free)
+{
+    heapBlockType *pNextBlock = heapBlockNext(pBlock);
+
+    if (free)
+    {
+        pBlock->size |= HEAP_BLOCK_FREE;
+        pNextBlock->size |= HEAP_BLOCK_PREV_FREE;
+        pNextBlock->prevPhysBlock = pBlock;
+    }
+    else
+    {
+        pBlock->size &= ~HEAP_BLOCK_FREE;
+        pNextBlock->size &= ~HEAP_BLOCK_PREV_FREE;
+    }
+}
+
+/**
+ * @brief Get first and second level indices of the free list holding blocks of the specified size
+ */
+static inline void heapMappingInsert(size_t size, uint32_t *pFl, uint32_t *pSl)
+{
+    if (size < HEAP_SMALL_BLOCK_SIZE)
+    {
+        *pFl = 0;
+        *pSl = size / (HEAP_SMALL_BLOCK_SIZE / HEAP_SL_INDEX_COUNT);
+    }
+    else
+    {
+        uint32_t msb = heapFls((uint32_t)size);
+
+        *pSl = (uint32_t)(size >> (msb - HEAP_SL_INDEX_COUNT_LOG2)) ^ HEAP_SL_INDEX_COUNT;
+        *pFl = msb - (HEAP_FL_INDEX_SHIFT - 1);
+    }
+}
+
+/**
+ * @brief Get indices of the first free list whose every block is at least of the specified size. Size is rounded up to
+ * the next list boundary, so that any block found is large enough without searching the list.
+ */
+static inline void heapMappingSearch(size_t size, uint32_t *pFl, uint32_t *pSl)
+{
+    if (size >= HEAP_SMALL_BLOCK_SIZE)
+    {
+        size += (1UL << (heapFls((uint32_t)size) - HEAP_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+
+    heapMappingInsert(size, pFl, pSl);
+}
+
+/**
+ * @brief Add a free block to the head of its free list
+ */
+static void heapFreeListAdd(heapHandleType *pHeap, heapBlockType *pBlock)
+{
+    uint32_t fl, sl;
+
+    heapMappingInsert(heapBlockSize(pBlock), &fl, &sl);
+
+    heapBlockType *pHead = pHeap->freeList[fl][sl];
+
+    pBlock->nextFreeBlock = pHead;
+    pBlock->prevFreeBlock = NULL;
+
+    if (pHead != NULL)
+    {
+        pHead->prevFreeBlock = pBlock;
+    }
+
+    pHeap->freeList[fl][sl] = pBlock;
+    pHeap->flBitmap |= 1UL << fl;
+    pHeap->slBitmap[fl] |= 1UL << sl;
+
+    pHeap->freeBytes += heapBlockSize(pBlock);
+    pHeap->freeBlockCount++;
+}
+
+/**
+ * @brief Remove a free block from its free list
+ */
+static void heapFreeListRemove(heapHandleType *pHeap, heapBlockType *pBlock)
+{
+    uint32_t fl, sl;
+
+    heapMappingInsert(heapBlockSize(pBlock), &fl, &sl);
+
+    if (pBlock->prevFreeBlock != NULL)
+    {
+        pBlock->prevFreeBlock->nextFreeBlock = pBlock->nextFreeBlock;
+    }
+    else
+    {
+        pHeap->freeList[fl][sl] = pBlock->nextFreeBlock;
+
+        if (pBlock->nextFreeBlock == NULL)
+        {
+            pHeap->slBitmap[fl] &= ~(1UL << sl);
+
+            if (pHeap->slBitmap[fl] == 0)
+            {
+                pHeap->flBitmap &= ~(1UL << fl);
+            }
+        }
+    }
+
+    if (pBlock->nextFreeBlock != NULL)
+    {
+        pBlock->nextFreeBlock->prevFreeBlock = pBlock->prevFreeBlock;
+    }
+
+    pHeap->freeBytes -= heapBlockSize(pBlock);
+    pHeap->freeBlockCount--;
+}
+
+/**
+ * @brief Find and remove a free block of at least the specified size
+ *
+ * @retval Pointer to the free block
+ * @retval NULL if no free block is large enough
+ */
+static heapBlockType *heapFreeListTake(heapHandleType *pHeap, size_t size)
+{
+    uint32_t fl, sl;
+
+    heapMappingSearch(size, &fl, &sl);
+
+    if (fl >= HEAP_FL_INDEX_COUNT)
+    {
+        return NULL;
+    }
+
+    /*Search the lists of the same class holding larger blocks first, then the larger classes*/
+    uint32_t slMap = pHeap->slBitmap[fl] & (~0UL << sl);
+
+    if (slMap == 0)
+    {
+        uint32_t flMap = (fl + 1 < 32) ? pHeap->flBitmap & (~0UL << (fl + 1)) : 0;
+
+        if (flMap == 0)
+        {
+            return NULL;
+        }
+
+        fl = heapFfs(flMap);
+        slMap = pHeap->slBitmap[fl];
+    }
+
+    heapBlockType *pBlock = pHeap->freeList[fl][heapFfs(slMap)];
+
+    heapFreeListRemove(pHeap, pBlock);
+
+    return pBlock;
+}
+
+/**
+ * @brief Split the memory of a block beyond the specified size into a new free block, if it is large enough to be a
+ * block. The new block is merged with the free block after it, if any.
+ */
+static void heapBlockTrim(heapHandleType *pHeap, heapBlockType *pBlock, size_t size)
+{
+    if (heapBlockSize(pBlock) < size + HEAP_BLOCK_HEADER_SIZE + HEAP_BLOCK_MIN_SIZE)
+    {
+        return;
+    }
+
+    heapBlockType *pRemainBlock = (heapBlockType *)((uint8_t *)heapBlockToPtr(pBlock) + size);
+
+    pRemainBlock->size = heapBlockSize(pBlock) - size - HEAP_BLOCK_HEADER_SIZE;
+    heapBlockSizeSet(pBlock, size);
+
+    heapBlockType *pNextBlock = heapBlockNext(pRemainBlock);
+
+    if (pNextBlock->size & HEAP_BLOCK_FREE)
+    {
+        heapFreeListRemove(pHeap, pNextBlock);
+        heapBlockSizeSet(pRemainBlock, heapBlockSize(pRemainBlock) + HEAP_BLOCK_HEADER_SIZE + heapBlockSize(pNextBlock));
+    }
+
+    heapBlockMarkFree(pRemainBlock, true);
+    heapFreeListAdd(pHeap, pRemainBlock);
+}
+
+/**
+ * @brief Round requested size up to the size of the block to be allocated
+ *
+ * @retval Block size
+ * @retval 0 if size is 0 or too large
+ */
+static inline size_t heapAdjustSize(size_t size)
+{
+    if (size == 0 || size > HEAP_BLOCK_MAX_SIZE)
+    {
+        return 0;
+    }
+
+    size = (size + HEAP_ALIGN_SIZE - 1) & ~(size_t)(HEAP_ALIGN_SIZE - 1);
+
+    return (size < HEAP_BLOCK_MIN_SIZE) ? HEAP_BLOCK_MIN_SIZE : size;
+}
+
+/**
+ * @brief Initialize heap without entering critical section
+ */
+static int heapInitUnlocked(heapHandleType *pHeap, void *pMemory, size_t size)
+{
+    uintptr_t start = ((uintptr_t)pMemory + HEAP_ALIGN_SIZE - 1) & ~(uintptr_t)(HEAP_ALIGN_SIZE - 1);
+    uintptr_t end = ((uintptr_t)pMemory + size) & ~(uintptr_t)(HEAP_ALIGN_SIZE - 1);
+
+    /*Memory must hold a free block and the sentinel block header*/
+    if (end <= start || end - start < 2 * HEAP_BLOCK_HEADER_SIZE + HEAP_BLOCK_MIN_SIZE ||
+        end - start - 2 * HEAP_BLOCK_HEADER_SIZE > HEAP_BLOCK_MAX_SIZE)
+    {
+        return RET_INVAL;
+    }
+
+    memset(pHeap, 0, sizeof(heapHandleType));
+
+    pHeap->pMemory = pMemory;
+    pHeap->memorySize = size;
+
+    heapBlockType *pBlock = (heapBlockType *)start;
+
+    pBlock->size = end - start - 2 * HEAP_BLOCK_HEADER_SIZE;
+
+    /*Sentinel block is never free; hence, a block is never merged beyond the end of the memory*/
+    heapBlockType *pSentinelBlock = heapBlockNext(pBlock);
+
+    pSentinelBlock->size = 0;
+
+    heapBlockMarkFree(pBlock, true);
+    heapFreeListAdd(pHeap, pBlock);
+
+    pHeap->totalBytes = pHeap->freeBytes;
+    pHeap->initialized = true;
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Initialize a heap over a memory region. Several heaps can be used independently over separate regions.
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param pMemory Start of the memory region
+ * @param size Size of the memory region in bytes. Blocks larger than (1 << OS_HEAP_MAX_SIZE_LOG2) bytes cannot be
+ * mapped; hence, the region must be smaller than this.
+ * @retval RET_SUCCESS if heap initialized successfully
+ * @retval RET_INVAL if the memory region is too small or too large
+ */
+int heapInit(heapHandleType *pHeap, void *pMemory, size_t size)
+{
+    assert(pHeap != NULL);
+    assert(pMemory != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    int retCode = heapInitUnlocked(pHeap, pMemory, size);
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Allocate a block without entering critical section
+ */
+static void *heapAllocUnlocked(heapHandleType *pHeap, size_t size)
+{
+    if (!pHeap->initialized && heapInitUnlocked(pHeap, pHeap->pMemory, pHeap->memorySize) != RET_SUCCESS)
+    {
+        return NULL;
+    }
+
+    size_t blockSize = heapAdjustSize(size);
+    heapBlockType *pBlock = (blockSize != 0) ? heapFreeListTake(pHeap, blockSize) : NULL;
+
+    if (pBlock == NULL)
+    {
+        pHeap->allocFailCount++;
+
+        return NULL;
+    }
+
+    heapBlockTrim(pHeap, pBlock, blockSize);
+    heapBlockMarkFree(pBlock, false);
+
+    pHeap->usedBytes += heapBlockSize(pBlock);
+    pHeap->allocCount++;
+
+    if (pHeap->usedBytes > pHeap->peakUsedBytes)
+    {
+        pHeap->peakUsedBytes = pHeap->usedBytes;
+    }
+
+    return heapBlockToPtr(pBlock);
+}
+
+/**
+ * @brief Free a block without entering critical section
+ */
+static void heapFreeUnlocked(heapHandleType *pHeap, void *ptr)
+{
+    heapBlockType *pBlock = heapBlockFromPtr(ptr);
+
+    assert(!(pBlock->size & HEAP_BLOCK_FREE));
+
+    pHeap->usedBytes -= heapBlockSize(pBlock);
+    pHeap->allocCount--;
+
+    /*Merge with the free block before it*/
+    if (pBlock->size & HEAP_BLOCK_PREV_FREE)
+    {
+        heapBlockType *pPrevBlock = pBlock->prevPhysBlock;
+
+        heapFreeListRemove(pHeap, pPrevBlock);
+        heapBlockSizeSet(pPrevBlock, heapBlockSize(pPrevBlock) + HEAP_BLOCK_HEADER_SIZE + heapBlockSize(pBlock));
+        pBlock = pPrevBlock;
+    }
+
+    /*Merge with the free block after it*/
+    heapBlockType *pNextBlock = heapBlockNext(pBlock);
+
+    if (pNextBlock->size & HEAP_BLOCK_FREE)
+    {
+        heapFreeListRemove(pHeap, pNextBlock);
+        heapBlockSizeSet(pBlock, heapBlockSize(pBlock) + HEAP_BLOCK_HEADER_SIZE + heapBlockSize(pNextBlock));
+    }
+
+    heapBlockMarkFree(pBlock, true);
+    heapFreeListAdd(pHeap, pBlock);
+}
+
+/**
+ * @brief Allocate memory from the heap in constant time. Can be called from an ISR.
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param size Number of bytes to allocate
+ * @retval Pointer to the allocated memory, aligned to HEAP_ALIGN_SIZE bytes
+ * @retval NULL if size is 0 or no free block is large enough
+ */
+void *heapAlloc(heapHandleType *pHeap, size_t size)
+{
+    assert(pHeap != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    void *ptr = heapAllocUnlocked(pHeap, size);
+
+    EXIT_CRITICAL_SECTION();
+
+    return ptr;
+}
+
+/**
+ * @brief Allocate zero-initialized memory for an array from the heap
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param count Number of array elements
+ * @param size Size of an array element in bytes
+ * @retval Pointer to the allocated memory
+ * @retval NULL if size of the array is 0 or too large
+ */
+void *heapCalloc(heapHandleType *pHeap, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+    {
+        return NULL;
+    }
+
+    void *ptr = heapAlloc(pHeap, count * size);
+
+    if (ptr != NULL)
+    {
+        memset(ptr, 0, count * size);
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief Free memory allocated from the heap in constant time. The freed block is merged with free blocks adjacent to
+ * it in memory. Nothing is done if ptr is NULL. Can be called from an ISR.
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param ptr Pointer to the memory allocated from the heap
+ */
+void heapFree(heapHandleType *pHeap, void *ptr)
+{
+    assert(pHeap != NULL);
+
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    ENTER_CRITICAL_SECTION();
+
+    heapFreeUnlocked(pHeap, ptr);
+
+    EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Resize memory allocated from the heap. The block is resized in place if it is large enough or the block after
+ * it is free and large enough. Otherwise, a new block is allocated and the contents are copied outside critical section.
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param ptr Pointer to the memory allocated from the heap. If NULL, this is the same as heapAlloc.
+ * @param size New size in bytes. If 0, the memory is freed and NULL returned.
+ * @retval Pointer to the resized memory
+ * @retval NULL if resizing failed; the memory is left unchanged in this case
+ */
+void *heapRealloc(heapHandleType *pHeap, void *ptr, size_t size)
+{
+    assert(pHeap != NULL);
+
+    if (ptr == NULL)
+    {
+        return heapAlloc(pHeap, size);
+    }
+
+    if (size == 0)
+    {
+        heapFree(pHeap, ptr);
+
+        return NULL;
+    }
+
+    size_t blockSize = heapAdjustSize(size);
+
+    if (blockSize == 0)
+    {
+        return NULL;
+    }
+
+    heapBlockType *pBlock = heapBlockFromPtr(ptr);
+    bool resized = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    size_t oldSize = heapBlockSize(pBlock);
+    heapBlockType *pNextBlock = heapBlockNext(pBlock);
+
+    /*Absorb the free block after the block, if that makes it large enough*/
+    if (oldSize < blockSize && (pNextBlock->size & HEAP_BLOCK_FREE) &&
+        oldSize + HEAP_BLOCK_HEADER_SIZE + heapBlockSize(pNextBlock) >= blockSize)
+    {
+        heapFreeListRemove(pHeap, pNextBlock);
+        heapBlockSizeSet(pBlock, oldSize + HEAP_BLOCK_HEADER_SIZE + heapBlockSize(pNextBlock));
+        heapBlockMarkFree(pBlock, false);
+    }
+
+    if (heapBlockSize(pBlock) >= blockSize)
+    {
+        heapBlockTrim(pHeap, pBlock, blockSize);
+
+        pHeap->usedBytes = pHeap->usedBytes - oldSize + heapBlockSize(pBlock);
+
+        if (pHeap->usedBytes > pHeap->peakUsedBytes)
+        {
+            pHeap->peakUsedBytes = pHeap->usedBytes;
+        }
+
+        resized = true;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (resized)
+    {
+        return ptr;
+    }
+
+    void *newPtr = heapAlloc(pHeap, size);
+
+    if (newPtr != NULL)
+    {
+        memcpy(newPtr, ptr, oldSize);
+        heapFree(pHeap, ptr);
+    }
+
+    return newPtr;
+}
+
+/**
+ * @brief Get usage and fragmentation statistics of the heap. The largest free block is found by searching the highest
+ * non-empty free list; hence, unlike allocation, this takes time proportional to the length of that list.
+ *
+ * @param pHeap Pointer to the heapHandle struct
+ * @param pStats Pointer to the heapStats struct to copy the statistics to
+ */
+void heapStatsGet(heapHandleType *pHeap, heapStatsType *pStats)
+{
+    assert(pHeap != NULL);
+    assert(pStats != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    if (!pHeap->initialized)
+    {
+        heapInitUnlocked(pHeap, pHeap->pMemory, pHeap->memorySize);
+    }
+
+    size_t largestFreeBytes = 0;
+
+    if (pHeap->flBitmap != 0)
+    {
+        uint32_t fl = heapFls(pHeap->flBitmap);
+        uint32_t sl = heapFls(pHeap->slBitmap[fl]);
+
+        for (heapBlockType *pBlock = pHeap->freeList[fl][sl]; pBlock != NULL; pBlock = pBlock->nextFreeBlock)
+        {
+            if (heapBlockSize(pBlock) > largestFreeBytes)
+            {
+                largestFreeBytes = heapBlockSize(pBlock);
+            }
+        }
+    }
+
+    pStats->totalBytes = pHeap->totalBytes;
+    pStats->usedBytes = pHeap->usedBytes;
+    pStats->peakUsedBytes = pHeap->peakUsedBytes;
+    pStats->freeBytes = pHeap->freeBytes;
+    pStats->largestFreeBytes = largestFreeBytes;
+    pStats->freeBlockCount = pHeap->freeBlockCount;
+    pStats->allocCount = pHeap->allocCount;
+    pStats->allocFailCount = pHeap->allocFailCount;
+    pStats->fragmentation = (pHeap->freeBytes != 0)
+                                ? (uint32_t)(10000 - (uint64_t)largestFreeBytes * 10000 / pHeap->freeBytes)
+                                : 0;
+
+    EXIT_CRITICAL_SECTION();
+}
+
+#if (OS_HEAP_NEWLIB) && !defined(PLATFORM_POSIX)
+struct _reent;
+
+/*Replacement of the newlib heap. Both the standard functions and the reentrant variants called by newlib itself are
+defined, so that the allocator of newlib is never linked.*/
+
+void *malloc(size_t size)
+{
+    return heapAlloc(&newlibHeap, size);
+}
+
+void free(void *ptr)
+{
+    heapFree(&newlibHeap, ptr);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    return heapCalloc(&newlibHeap, count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    return heapRealloc(&newlibHeap, ptr, size);
+}
+
+void *_malloc_r(struct _reent *pReent, size_t size)
+{
+    (void)pReent;
+
+    return heapAlloc(&newlibHeap, size);
+}
+
+void _free_r(struct _reent *pReent, void *ptr)
+{
+    (void)pReent;
+
+    heapFree(&newlibHeap, ptr);
+}
+
+void *_calloc_r(struct _reent *pReent, size_t count, size_t size)
+{
+    (void)pReent;
+
+    return heapCalloc(&newlibHeap, count, size);
+}
+
+void *_realloc_r(struct _reent *pReent, void *ptr, size_t size)
+{
+    (void)pReent;
+
+    return heapRealloc(&newlibHeap, ptr, size);
+}
+#endif
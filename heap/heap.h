@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_HEAP_H
+#define __SANO_RTOS_HEAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "osConfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define HEAP_ALIGN_SIZE 8 // Alignment of the allocated memory
+
+#define HEAP_SL_INDEX_COUNT_LOG2 4                                         // log2 of number of second level lists per first level class
+#define HEAP_SL_INDEX_COUNT (1UL << HEAP_SL_INDEX_COUNT_LOG2)              // Number of second level lists per first level class
+#define HEAP_FL_INDEX_SHIFT (HEAP_SL_INDEX_COUNT_LOG2 + 3)                 // Sizes below (1 << HEAP_FL_INDEX_SHIFT) share the first class
+#define HEAP_FL_INDEX_COUNT (OS_HEAP_MAX_SIZE_LOG2 - HEAP_FL_INDEX_SHIFT + 1) // Number of first level classes
+
+#if (OS_HEAP_MAX_SIZE_LOG2 <= HEAP_FL_INDEX_SHIFT) || (OS_HEAP_MAX_SIZE_LOG2 > 31)
+#error "OS_HEAP_MAX_SIZE_LOG2 must be in the range 8 to 31"
+#endif
+
+/**
+ * @brief Statically define a heap over a static memory region. The heap is initialized on its first use.
+ * @param name Name of the heap.
+ * @param size Size of the memory region in bytes.
+ */
+#define HEAP_DEFINE(name, size)                            \
+    uint64_t name##Memory[((size) + 7) / sizeof(uint64_t)]; \
+    heapHandleType name = {                                \
+        .pMemory = name##Memory,                           \
+        .memorySize = sizeof(name##Memory),                \
+        .initialized = false}
+
+    /*Header of a block of heap memory. Memory of a block follows its header; links of a free block are kept at the
+    start of its memory, hence, the overhead of an allocated block is only the first two members.*/
+    typedef struct heapBlock
+    {
+        struct heapBlock *prevPhysBlock; // Block just before this block in memory. Valid only if that block is free.
+        size_t size;                     // Size of the block memory in bytes. Low bits hold HEAP_BLOCK_FREE and HEAP_BLOCK_PREV_FREE flags.
+        struct heapBlock *nextFreeBlock; // Next block in the free list
+        struct heapBlock *prevFreeBlock; // Previous block in the free list
+    } heapBlockType;
+
+    /*Two-Level Segregated Fit(TLSF) heap. Free blocks are kept in lists segregated by size: a first level class per power
+    of 2, each split linearly into HEAP_SL_INDEX_COUNT second level lists. Bit n of flBitmap is set if any list of class n
+    is non-empty, and bit m of slBitmap[n] if list m of class n is non-empty; hence, a free block large enough for a
+    request is found, and freed blocks are merged with their free neighbours, in constant time.*/
+    typedef struct
+    {
+        uint32_t flBitmap;
+        uint32_t slBitmap[HEAP_FL_INDEX_COUNT];
+        heapBlockType *freeList[HEAP_FL_INDEX_COUNT][HEAP_SL_INDEX_COUNT];
+        void *pMemory;          // Memory region of a heap initialized on its first use
+        size_t memorySize;      // Size of the memory region
+        size_t totalBytes;      // Bytes available for allocation after initialization
+        size_t usedBytes;       // Bytes of the allocated blocks
+        size_t peakUsedBytes;   // Maximum usedBytes
+        size_t freeBytes;       // Bytes of the free blocks
+        uint32_t freeBlockCount;
+        uint32_t allocCount;     // Number of allocated blocks
+        uint32_t allocFailCount; // Number of failed allocations
+        bool initialized;
+    } heapHandleType;
+
+    /*Usage statistics of a heap*/
+    typedef struct
+    {
+        size_t totalBytes;       // Bytes available for allocation after initialization
+        size_t usedBytes;        // Bytes of the allocated blocks, including rounding up of requested sizes
+        size_t peakUsedBytes;    // Maximum usedBytes
+        size_t freeBytes;        // Bytes of the free blocks
+        size_t largestFreeBytes; // Size of the largest free block
+        uint32_t freeBlockCount; // Number of free blocks
+        uint32_t allocCount;     // Number of allocated blocks
+        uint32_t allocFailCount; // Number of failed allocations
+        uint32_t fragmentation;  // (1 - largestFreeBytes / freeBytes) in hundredths of a percent[0 to 10000]
+    } heapStatsType;
+
+    int heapInit(heapHandleType *pHeap, void *pMemory, size_t size);
+
+    void *heapAlloc(heapHandleType *pHeap, size_t size);
+
+    void *heapCalloc(heapHandleType *pHeap, size_t count, size_t size);
+
+    void *heapRealloc(heapHandleType *pHeap, void *ptr, size_t size);
+
+    void heapFree(heapHandleType *pHeap, void *ptr);
+
+    void heapStatsGet(heapHandleType *pHeap, heapStatsType *pStats);
+
+#if (OS_HEAP_NEWLIB) && !defined(PLATFORM_POSIX)
+    extern heapHandleType newlibHeap;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
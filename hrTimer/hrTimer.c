@@ -0,0 +1,457 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include "osConfig.h"
+#include "scheduler/scheduler.h"
+#include "hrTimer.h"
+
+#if (OS_HR_TIMER)
+
+static hrAlarmType *alarmHead = NULL; // Armed alarms sorted by deadline
+
+static bool processingAlarms = false; // Set while expired alarms are being processed
+
+#if (OS_HR_TIMER_SYSTICK)
+
+/*Minimum number of cycles remaining in the current SysTick segment for its reload value to be safely changed
+ without stopping SysTick*/
+#define HR_TIMER_LOAD_WRITE_MARGIN 32
+
+/*Number of cycles from reading SysTick VAL to writing it, when the current segment is split. SysTick keeps counting
+ meanwhile; these cycles are added to the end of the new segment so that time does not drift. Depends on the core and
+ flash wait states; the value covers the few instructions between the read and the write on Cortex-M3/M4 running from
+ zero wait state memory.*/
+#define HR_TIMER_VAL_WRITE_CYCLES 8
+
+/*SysTick counts time in segments. Normally, a segment is one tick period. To generate an alarm between two ticks,
+ the tick period is split into two segments at the alarm deadline; hence, tick rate is not affected. Time in CPU
+ cycles is computed from the time at which the current segment ends and the SysTick counter value.*/
+static volatile uint64_t segmentEndCycles = 0; // Time at which the current SysTick segment ends
+static volatile uint64_t nextTickCycles = 0;   // Time at which the current tick period ends
+
+/**
+ * @brief Program SysTick to end a segment at the deadline of the earliest alarm if it expires before the end of the current
+ * tick period. Segments shorter than OS_HR_TIMER_MIN_CYCLES are never created; alarms that would require one expire at the
+ * end of the nearest segment instead. This function must be called with interrupts disabled.
+ */
+static void sysTickCompareSet()
+{
+    uint32_t tickCycles = OS_INTERVAL_CPU_TICKS;
+
+    /*Split the current segment if the earliest alarm expires before it ends*/
+    if (alarmHead != NULL && alarmHead->deadlineCycles < segmentEndCycles)
+    {
+        /*If the current segment has already ended, SysTick interrupt handler will program SysTick again.
+        Reload value must not be changed until then, as it is used by the handler to find the end of the next segment.*/
+        if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+        {
+            return;
+        }
+
+        uint64_t now = segmentEndCycles - 1 - SysTick->VAL;
+        uint64_t splitCycles = alarmHead->deadlineCycles;
+
+        if (splitCycles < now + OS_HR_TIMER_MIN_CYCLES)
+        {
+            splitCycles = now + OS_HR_TIMER_MIN_CYCLES;
+        }
+
+        if (splitCycles + OS_HR_TIMER_MIN_CYCLES <= nextTickCycles)
+        {
+            uint32_t reload = (uint32_t)(splitCycles - now) - 1;
+
+            /*SysTick is not stopped; hence, no cycles are lost. The new segment starts when VAL is written, so its end is
+            computed from VAL read just before the write. If the current segment is about to end or has ended meanwhile,
+            leave it to SysTick interrupt handler.*/
+            uint32_t val = SysTick->VAL;
+
+            if (val <= HR_TIMER_LOAD_WRITE_MARGIN || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+            {
+                return;
+            }
+
+            SysTick->LOAD = reload;
+            SysTick->VAL = 0;
+
+            segmentEndCycles = segmentEndCycles - 1 - val + HR_TIMER_VAL_WRITE_CYCLES + reload + 1;
+        }
+    }
+
+    /*Program the length of the next segment, which is loaded by SysTick when the current segment ends. Next segment
+    ends at the end of the tick period, unless the earliest alarm expires before that.*/
+    uint64_t nextSegmentEndCycles = (segmentEndCycles == nextTickCycles) ? (nextTickCycles + tickCycles) : nextTickCycles;
+
+    if (alarmHead != NULL && alarmHead->deadlineCycles > segmentEndCycles && alarmHead->deadlineCycles < nextSegmentEndCycles)
+    {
+        uint64_t splitCycles = alarmHead->deadlineCycles;
+
+        if (splitCycles < segmentEndCycles + OS_HR_TIMER_MIN_CYCLES)
+        {
+            splitCycles = segmentEndCycles + OS_HR_TIMER_MIN_CYCLES;
+        }
+
+        if (splitCycles + OS_HR_TIMER_MIN_CYCLES <= nextSegmentEndCycles)
+        {
+            nextSegmentEndCycles = splitCycles;
+        }
+    }
+
+    /*If the current segment is about to end or has already ended, leave the reload value unchanged. SysTick interrupt
+    handler will program it.*/
+    if (SysTick->VAL > HR_TIMER_LOAD_WRITE_MARGIN && !(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        SysTick->LOAD = (uint32_t)(nextSegmentEndCycles - segmentEndCycles) - 1;
+    }
+}
+
+/**
+ * @brief Update time at the end of a SysTick segment. This function must be called first from SysTick interrupt handler.
+ *
+ * @retval true if the ended segment completed a tick period
+ * @retval false if the ended segment was ended early for an alarm
+ */
+bool hrTimerSysTickSegmentEnd()
+{
+    bool tickEnded = (segmentEndCycles == nextTickCycles);
+
+    if (tickEnded)
+    {
+        nextTickCycles += OS_INTERVAL_CPU_TICKS;
+    }
+
+    /*Next segment has started with the reload value programmed during the ended segment*/
+    segmentEndCycles += SysTick->LOAD + 1;
+
+    return tickEnded;
+}
+
+/**
+ * @brief Get number of ticks for which tickless idle mode can be entered without missing an alarm.
+ *
+ * @retval Number of ticks until the tick period in which the earliest alarm expires ends
+ * @retval 0 if the current tick period is split for an alarm
+ * @retval UINT32_MAX if no alarm is armed
+ */
+uint32_t hrTimerNextAlarmTicks()
+{
+    /*Tickless idle sleep assumes that the current SysTick segment ends at the end of the tick period*/
+    if (segmentEndCycles != nextTickCycles)
+    {
+        return 0;
+    }
+
+    if (alarmHead == NULL)
+    {
+        return UINT32_MAX;
+    }
+
+    if (alarmHead->deadlineCycles < nextTickCycles)
+    {
+        return 0;
+    }
+
+    uint64_t ticks = (alarmHead->deadlineCycles - nextTickCycles) / OS_INTERVAL_CPU_TICKS + 1;
+
+    return (ticks > UINT32_MAX) ? UINT32_MAX : (uint32_t)ticks;
+}
+
+/**
+ * @brief Update time after tickless idle sleep, which restarts SysTick aligned to the end of the tick period.
+ *
+ * @param elapsedTicks Number of ticks elapsed while sleeping and not processed by SysTick handler
+ */
+void hrTimerTicklessResync(uint32_t elapsedTicks)
+{
+    nextTickCycles += (uint64_t)elapsedTicks * OS_INTERVAL_CPU_TICKS;
+
+    segmentEndCycles = nextTickCycles;
+}
+
+#else
+
+/**
+ * @brief SysTick independent compare interrupt handler. This function must be called from the interrupt handler of
+ * the compare channel programmed by hrCounterCompareSet.
+ */
+void hrTimerCompareHandler()
+{
+    __disable_irq();
+
+    hrTimerProcessAlarms();
+
+    __enable_irq();
+
+    /*Perform context switch if a higher priority task has been woken up by an alarm*/
+    schedulerReschedule();
+}
+
+#endif
+
+/**
+ * @brief Program compare interrupt for the earliest alarm. This function must be called with interrupts disabled.
+ */
+static void hrTimerCompareUpdate()
+{
+    /*Compare interrupt is programmed once all the expired alarms have been processed*/
+    if (processingAlarms)
+    {
+        return;
+    }
+
+#if (OS_HR_TIMER_SYSTICK)
+    sysTickCompareSet();
+#else
+    hrCounterCompareSet((alarmHead != NULL) ? alarmHead->deadlineCycles : UINT64_MAX);
+#endif
+}
+
+/**
+ * @brief Get current time in CPU cycles. This function must be called with interrupts disabled.
+ *
+ * @return Number of CPU cycles elapsed since the scheduler started
+ */
+static uint64_t hrTimerCyclesGetUnlocked()
+{
+#if (OS_HR_TIMER_SYSTICK)
+    uint32_t value = SysTick->VAL;
+
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        /*Current segment has ended, but SysTick interrupt is yet to be handled. Counter value read above might be from
+        either segment; hence, read it again.*/
+        value = SysTick->VAL;
+
+        return segmentEndCycles + (SysTick->LOAD - value);
+    }
+
+    return segmentEndCycles - 1 - value;
+#else
+    return hrCounterRead();
+#endif
+}
+
+/**
+ * @brief Insert alarm into the list of armed alarms, after alarms having the same or earlier deadline.
+ *
+ * @param pAlarm Pointer to the hrAlarm struct
+ */
+static void hrAlarmInsert(hrAlarmType *pAlarm)
+{
+    hrAlarmType *prevAlarm = NULL;
+    hrAlarmType *currentAlarm = alarmHead;
+
+    while (currentAlarm != NULL && currentAlarm->deadlineCycles <= pAlarm->deadlineCycles)
+    {
+        prevAlarm = currentAlarm;
+        currentAlarm = currentAlarm->nextAlarm;
+    }
+
+    pAlarm->prevAlarm = prevAlarm;
+    pAlarm->nextAlarm = currentAlarm;
+
+    if (currentAlarm != NULL)
+    {
+        currentAlarm->prevAlarm = pAlarm;
+    }
+
+    if (prevAlarm != NULL)
+    {
+        prevAlarm->nextAlarm = pAlarm;
+    }
+    else
+    {
+        alarmHead = pAlarm;
+    }
+}
+
+/**
+ * @brief Remove alarm from the list of armed alarms
+ *
+ * @param pAlarm Pointer to the hrAlarm struct
+ */
+static void hrAlarmRemove(hrAlarmType *pAlarm)
+{
+    if (pAlarm->prevAlarm != NULL)
+    {
+        pAlarm->prevAlarm->nextAlarm = pAlarm->nextAlarm;
+    }
+    else
+    {
+        alarmHead = pAlarm->nextAlarm;
+    }
+
+    if (pAlarm->nextAlarm != NULL)
+    {
+        pAlarm->nextAlarm->prevAlarm = pAlarm->prevAlarm;
+    }
+
+    pAlarm->nextAlarm = NULL;
+    pAlarm->prevAlarm = NULL;
+}
+
+/**
+ * @brief Initialize high resolution time. Time is counted from the call to this function by schedulerStart.
+ */
+void hrTimerInit()
+{
+#if (OS_HR_TIMER_SYSTICK)
+    /*Current tick period ends when SysTick counter reaches zero*/
+    segmentEndCycles = (uint64_t)SysTick->VAL + 1;
+    nextTickCycles = segmentEndCycles;
+#endif
+}
+
+/**
+ * @brief Get current time in CPU cycles. This function can be called from tasks, interrupt handlers and critical sections.
+ *
+ * @return Number of CPU cycles elapsed since the scheduler started
+ */
+uint64_t hrTimerCyclesGet()
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    uint64_t cycles = hrTimerCyclesGetUnlocked();
+
+    __set_PRIMASK(primask);
+
+    return cycles;
+}
+
+/**
+ * @brief Get current time in microseconds.
+ *
+ * @return Number of microseconds elapsed since the scheduler started
+ */
+uint64_t hrTimerUSGet()
+{
+    uint64_t cycles = hrTimerCyclesGet();
+
+    /*Convert seconds and remaining cycles separately to avoid overflow*/
+    return (cycles / SystemCoreClock) * 1000000 + (cycles % SystemCoreClock) * 1000000 / SystemCoreClock;
+}
+
+/**
+ * @brief Arm a one-shot alarm to expire at the specified time. If the alarm is already armed, it is re-armed. Alarm callback
+ * is executed from interrupt context once the time is reached. If the time has already passed, the alarm expires as soon as possible.
+ * This function can be called from tasks, interrupt handlers, critical sections and alarm callbacks.
+ *
+ * @param pAlarm Pointer to the hrAlarm struct
+ * @param deadlineCycles Time in CPU cycles[see hrTimerCyclesGet] at which the alarm expires
+ * @param callback Function to execute when the alarm expires
+ * @param context Pointer stored in the alarm for use by the callback
+ */
+void hrAlarmStart(hrAlarmType *pAlarm, uint64_t deadlineCycles, hrAlarmCallbackType callback, void *context)
+{
+    assert(pAlarm != NULL);
+    assert(callback != NULL);
+
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if (pAlarm->isArmed)
+    {
+        hrAlarmRemove(pAlarm);
+    }
+
+    pAlarm->deadlineCycles = deadlineCycles;
+    pAlarm->callback = callback;
+    pAlarm->context = context;
+    pAlarm->isArmed = true;
+
+    hrAlarmInsert(pAlarm);
+
+    /*Compare interrupt needs to be reprogrammed only if the earliest deadline has changed*/
+    if (alarmHead == pAlarm)
+    {
+        hrTimerCompareUpdate();
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Disarm an alarm. Stopping an alarm which is not armed has no effect.
+ *
+ * @param pAlarm Pointer to the hrAlarm struct
+ */
+void hrAlarmStop(hrAlarmType *pAlarm)
+{
+    assert(pAlarm != NULL);
+
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    if (pAlarm->isArmed)
+    {
+        bool wasHead = (alarmHead == pAlarm);
+
+        hrAlarmRemove(pAlarm);
+
+        pAlarm->isArmed = false;
+
+        if (wasHead)
+        {
+            hrTimerCompareUpdate();
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief Execute callbacks of the expired alarms and program compare interrupt for the earliest remaining alarm.
+ * This function is called from SysTick or compare interrupt handler with interrupts disabled.
+ */
+void hrTimerProcessAlarms()
+{
+    uint64_t now = hrTimerCyclesGetUnlocked();
+
+    processingAlarms = true;
+
+    while (alarmHead != NULL && alarmHead->deadlineCycles <= now)
+    {
+        hrAlarmType *pAlarm = alarmHead;
+
+        hrAlarmRemove(pAlarm);
+
+        pAlarm->isArmed = false;
+
+        /*Callback might re-arm the alarm*/
+        pAlarm->callback(pAlarm);
+    }
+
+    processingAlarms = false;
+
+    hrTimerCompareUpdate();
+}
+
+#endif
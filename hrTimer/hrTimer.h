@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_HR_TIMER_H
+#define __SANO_RTOS_HR_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if (OS_HR_TIMER)
+
+#if !(TASK_RUN_PRIVILEGED)
+#error "OS_HR_TIMER requires TASK_RUN_PRIVILEGED"
+#endif
+
+    struct hrAlarm;
+
+    typedef void (*hrAlarmCallbackType)(struct hrAlarm *pAlarm); // Alarm callback function type definition
+
+    /*One-shot alarm expiring at an absolute time in CPU cycles. Alarm callback is executed from interrupt context
+    with interrupts disabled; hence, it must be short and must not block.*/
+    typedef struct hrAlarm
+    {
+        uint64_t deadlineCycles;
+        hrAlarmCallbackType callback;
+        void *context;
+        struct hrAlarm *nextAlarm;
+        struct hrAlarm *prevAlarm;
+        bool isArmed;
+    } hrAlarmType;
+
+#if !(OS_HR_TIMER_SYSTICK)
+    /*Functions to be provided by the application when a free running hardware counter is used instead of SysTick.
+    hrCounterRead must return the number of CPU cycles elapsed since the counter was started, and hrCounterCompareSet
+    must program the compare interrupt of the counter to fire at the specified time[UINT64_MAX if no alarm is armed].
+    hrTimerCompareHandler must be called from the compare interrupt handler.*/
+    extern uint64_t hrCounterRead();
+
+    extern void hrCounterCompareSet(uint64_t deadlineCycles);
+
+    void hrTimerCompareHandler();
+#endif
+
+    void hrTimerInit();
+
+    uint64_t hrTimerCyclesGet();
+
+    uint64_t hrTimerUSGet();
+
+    void hrAlarmStart(hrAlarmType *pAlarm, uint64_t deadlineCycles, hrAlarmCallbackType callback, void *context);
+
+    void hrAlarmStop(hrAlarmType *pAlarm);
+
+    void hrTimerProcessAlarms();
+
+#if (OS_HR_TIMER_SYSTICK)
+    bool hrTimerSysTickSegmentEnd();
+
+    uint32_t hrTimerNextAlarmTicks();
+
+    void hrTimerTicklessResync(uint32_t elapsedTicks);
+#endif
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
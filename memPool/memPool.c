@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <assert.h>
+#include "retCodes.h"
+#include "osConfig.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "taskQueue/taskQueue.h"
+#include "memPool.h"
+
+/**
+ * @brief Take a block from the memory pool without entering critical section. Freed blocks are reused first;
+ * blocks never allocated before are taken in order, so that the pool needs no initialization.
+ *
+ * @param pPool Pointer to the memPoolHandle struct
+ * @retval Pointer to the block
+ * @retval NULL if all blocks are in use
+ */
+static void *memPoolTake(memPoolHandleType *pPool)
+{
+    void *pBlock = NULL;
+
+    if (pPool->freeList != NULL)
+    {
+        pBlock = pPool->freeList;
+        pPool->freeList = pPool->freeList->next;
+    }
+    else if (pPool->unusedBlockIndex < pPool->blockCount)
+    {
+        pBlock = &pPool->buffer[pPool->unusedBlockIndex * pPool->blockSize];
+        pPool->unusedBlockIndex++;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    pPool->usedCount++;
+
+    if (pPool->usedCount > pPool->peakUsedCount)
+    {
+        pPool->peakUsedCount = pPool->usedCount;
+    }
+
+    return pBlock;
+}
+
+/**
+ * @brief Allocate a block from the memory pool. If all blocks are in use, block the task for specified number of
+ * wait ticks. If calling this function from an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ *
+ * @param pPool Pointer to the memPoolHandle struct
+ * @param waitTicks Number of ticks to wait for a block to be freed
+ * @retval Pointer to the allocated block
+ * @retval NULL if no block is available or wait timed out
+ */
+void *memPoolAlloc(memPoolHandleType *pPool, uint32_t waitTicks)
+{
+    assert(pPool != NULL);
+
+    void *pBlock;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    pBlock = memPoolTake(pPool);
+
+    if (pBlock == NULL && waitTicks != TASK_NO_WAIT)
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        /*Put current task in memory pool's wait queue*/
+        taskQueueAdd(&pPool->waitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that a block cannot be freed before the task is blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MEM_POOL_BLOCK, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        /* Give CPU to other tasks while waiting for a block to be freed*/
+        taskYield();
+
+        /*Re-enter critical section after being unblocked*/
+        ENTER_CRITICAL_SECTION();
+
+        if (currentTask->wakeupReason != WAIT_TIMEOUT)
+        {
+            /*Block freed or task suspended while waiting and later resumed. In both cases, try allocating again.
+            Remove task from the waitQueue(if still there) before retrying, as its queue node will be re-used.*/
+            taskQueueRemove(&pPool->waitQueue, &currentTask->waitNode);
+
+            goto retry;
+        }
+
+        /*Wait timed out,remove task from  the waitQueue.*/
+        taskQueueRemove(&pPool->waitQueue, &currentTask->waitNode);
+    }
+
+    if (pBlock == NULL)
+    {
+        pPool->allocFailCount++;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return pBlock;
+}
+
+/**
+ * @brief Return a block to the memory pool. The highest priority task waiting for a block is made ready.
+ * Can be called from an ISR.
+ *
+ * @param pPool Pointer to the memPoolHandle struct
+ * @param pBlock Pointer to the block allocated from the memory pool
+ * @retval RET_SUCCESS if block freed successfully
+ * @retval RET_INVAL if pBlock is not a block of the memory pool or has never been allocated, or no block is allocated
+ */
+int memPoolFree(memPoolHandleType *pPool, void *pBlock)
+{
+    assert(pPool != NULL);
+
+    uintptr_t offset = (uintptr_t)pBlock - (uintptr_t)pPool->buffer;
+
+    if (pBlock == NULL || offset >= pPool->blockCount * pPool->blockSize || offset % pPool->blockSize != 0)
+    {
+        return RET_INVAL;
+    }
+
+    bool contextSwitchRequired = false;
+
+    taskHandleType *nextTask = NULL;
+
+    ENTER_CRITICAL_SECTION();
+
+    /*Blocks from unusedBlockIndex onwards have never been allocated; freeing one would hand it out twice*/
+    if (offset / pPool->blockSize >= pPool->unusedBlockIndex || pPool->usedCount == 0)
+    {
+        EXIT_CRITICAL_SECTION();
+
+        return RET_INVAL;
+    }
+
+    ((memPoolFreeBlockType *)pBlock)->next = pPool->freeList;
+    pPool->freeList = (memPoolFreeBlockType *)pBlock;
+    pPool->usedCount--;
+
+    /*Get next highest priority task to unblock from the wait Queue*/
+getNextTask:
+    nextTask = taskQueueGet(&pPool->waitQueue);
+
+    if (nextTask != NULL)
+    {
+        /*If task was suspended while waiting for a block, skip the task and get another waiting task from the waitQueue.*/
+        if (nextTask->status == TASK_STATUS_SUSPENDED)
+        {
+            goto getNextTask;
+        }
+
+        taskSetReady(nextTask, MEM_POOL_BLOCK_FREED);
+
+        /*Perform context switch if unblocked task has equal or
+         *higher priority[lower priority value] than that of current task */
+        if (nextTask->priority <= taskPool.currentTask->priority)
+        {
+            contextSwitchRequired = true;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Get usage statistics of the memory pool
+ *
+ * @param pPool Pointer to the memPoolHandle struct
+ * @param pStats Pointer to the memPoolStats struct to copy the statistics to
+ */
+void memPoolStatsGet(memPoolHandleType *pPool, memPoolStatsType *pStats)
+{
+    assert(pPool != NULL);
+    assert(pStats != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    pStats->blockSize = pPool->blockSize;
+    pStats->blockCount = pPool->blockCount;
+    pStats->usedCount = pPool->usedCount;
+    pStats->peakUsedCount = pPool->peakUsedCount;
+    pStats->allocFailCount = pPool->allocFailCount;
+
+    EXIT_CRITICAL_SECTION();
+}
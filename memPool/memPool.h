@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_MEM_POOL_H
+#define __SANO_RTOS_MEM_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*Size of a memory pool block rounded up to a multiple of 8 bytes, so that every block is 8-byte aligned and can hold
+the free list link*/
+#define MEM_POOL_BLOCK_SIZE(blockSize) (((blockSize) + 7) & ~7UL)
+
+/**
+ * @brief Statically define and initialize a memory pool of fixed size blocks. Blocks are allocated and freed in
+ * constant time from tasks and ISRs.
+ * @param name Name of the memory pool.
+ * @param block_size Size of a block in bytes. Rounded up to a multiple of 8 bytes.
+ * @param count Number of blocks in the memory pool.
+ */
+#define MEMPOOL_DEFINE(name, block_size, count)                                          \
+    uint64_t name##Buffer[MEM_POOL_BLOCK_SIZE(block_size) * (count) / sizeof(uint64_t)]; \
+    memPoolHandleType name = {                                                           \
+        .waitQueue = {0},                                                                \
+        .buffer = (uint8_t *)name##Buffer,                                               \
+        .freeList = NULL,                                                                \
+        .blockSize = MEM_POOL_BLOCK_SIZE(block_size),                                    \
+        .blockCount = count,                                                             \
+        .unusedBlockIndex = 0,                                                           \
+        .usedCount = 0,                                                                  \
+        .peakUsedCount = 0,                                                              \
+        .allocFailCount = 0}
+
+    /*Link of a free block, kept in the block itself*/
+    typedef struct memPoolFreeBlock
+    {
+        struct memPoolFreeBlock *next;
+    } memPoolFreeBlockType;
+
+    typedef struct
+    {
+        taskQueueType waitQueue; // Tasks waiting for a block to be freed
+        uint8_t *buffer;
+        memPoolFreeBlockType *freeList; // Freed blocks
+        uint32_t blockSize;
+        uint32_t blockCount;
+        uint32_t unusedBlockIndex; // Blocks from this index onwards have never been allocated
+        uint32_t usedCount;
+        uint32_t peakUsedCount;
+        uint32_t allocFailCount; // Number of allocations failed or timed out
+    } memPoolHandleType;
+
+    /*Usage statistics of a memory pool*/
+    typedef struct
+    {
+        uint32_t blockSize;      // Size of a block in bytes
+        uint32_t blockCount;     // Number of blocks in the pool
+        uint32_t usedCount;      // Number of blocks currently allocated
+        uint32_t peakUsedCount;  // Maximum number of blocks allocated at a time
+        uint32_t allocFailCount; // Number of allocations failed or timed out
+    } memPoolStatsType;
+
+    void *memPoolAlloc(memPoolHandleType *pPool, uint32_t waitTicks);
+
+    int memPoolFree(memPoolHandleType *pPool, void *pBlock);
+
+    void memPoolStatsGet(memPoolHandleType *pPool, memPoolStatsType *pStats);
+
+    /**
+     * @brief Get number of free blocks in the memory pool
+     *
+     * @param pPool Pointer to the memPoolHandle struct
+     * @return Number of free blocks
+     */
+    static inline uint32_t memPoolFreeCount(memPoolHandleType *pPool)
+    {
+        return pPool->blockCount - pPool->usedCount;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
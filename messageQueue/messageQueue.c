@@ -29,99 +29,208 @@
 #include "mutex/mutex.h"
 #include "task/task.h"
 #include "scheduler/scheduler.h"
+#include "trace/trace.h"
 #include "taskQueue/taskQueue.h"
 
 /**
- * @brief Insert an item to the queue buffer
- *
- * @param pQueueHandle
- * @param pItem
+ * @brief Check if an item can be written to the queue. No item can be written while a slot is reserved, as items must
+ * be committed in the order of their slots.
  */
-static void msgQueueBufferWrite(msgQueueHandleType *pQueueHandle, void *pItem)
+static inline bool msgQueueWritable(msgQueueHandleType *pQueueHandle)
 {
+    return !pQueueHandle->writeReserved && !msgQueueFull(pQueueHandle);
+}
 
-    bool contextSwitchRequired = false;
-
-    taskHandleType *consumer = NULL;
+/**
+ * @brief Check if an item can be read from the queue. No item can be read while the front item is borrowed.
+ */
+static inline bool msgQueueReadable(msgQueueHandleType *pQueueHandle)
+{
+    return !pQueueHandle->readBorrowed && !msgQueueEmpty(pQueueHandle);
+}
 
-    ENTER_CRITICAL_SECTION();
+/**
+ * @brief Make ready the highest priority task waiting in a wait queue of the msgQueue. Tasks suspended while waiting
+ * are skipped. This function must be called from within a critical section.
+ *
+ * @param pWaitQueue Pointer to producerWaitQueue or consumerWaitQueue of the msgQueue
+ * @param wakeupReason Wakeup reason
+ * @retval true if the task made ready has equal or higher priority[lower priority value] than that of current task
+ * @retval false otherwise
+ */
+bool msgQueueWakeup(taskQueueType *pWaitQueue, wakeupReasonType wakeupReason)
+{
+    taskHandleType *pTask;
 
-    memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex], pItem, pQueueHandle->itemSize);
-    pQueueHandle->writeIndex = (pQueueHandle->writeIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
-    pQueueHandle->itemCount++;
+getNextTask:
+    pTask = taskQueueGet(pWaitQueue);
 
-    // Get next waiting consumer task to unblock
-getNextConsumer:
-    consumer = taskQueueGet(&pQueueHandle->consumerWaitQueue);
-    if (consumer != NULL)
+    if (pTask == NULL)
     {
-        /*If task was suspended while waiting for Queue data, skipt the task and get another waiting task from the waitQueue*/
-        if (consumer->status == TASK_STATUS_SUSPENDED)
-        {
-            goto getNextConsumer;
-        }
-        taskSetReady(consumer, MSG_QUEUE_DATA_AVAILABLE);
+        return false;
+    }
 
-        /*Perform context switch if  unblocked consumer task has equal or
-         *higher priority[lower priority value] than that of current task */
-        if (consumer->priority <= taskPool.currentTask->priority)
-        {
-            contextSwitchRequired = true;
-        }
+    /*If task was suspended while waiting, skip the task and get another waiting task from the wait Queue*/
+    if (pTask->status == TASK_STATUS_SUSPENDED)
+    {
+        goto getNextTask;
     }
 
-    EXIT_CRITICAL_SECTION();
+    taskSetReady(pTask, wakeupReason);
 
-    if (contextSwitchRequired)
+    return pTask->priority <= taskPool.currentTask->priority;
+}
+
+/**
+ * @brief Block the current task in a wait queue of a message queue defined with MSG_QUEUE_TYPED_DEFINE. This function
+ * must be called from within a critical section, which is exited while the task is blocked.
+ *
+ * @param pWaitQueue Pointer to producerWaitQueue or consumerWaitQueue of the msgQueue
+ * @param blockedReason Block reason
+ * @param waitTicks Number of ticks to wait
+ * @param noWaitRetCode Code to return if waitTicks is TASK_NO_WAIT
+ * @retval RET_SUCCESS if the task was made ready by the other end or resumed; the queue must be checked again
+ * @retval RET_TIMEOUT if wait timeout occured
+ * @retval noWaitRetCode if waitTicks is TASK_NO_WAIT
+ */
+int msgQueueTypedWait(taskQueueType *pWaitQueue, blockedReasonType blockedReason, uint32_t waitTicks, int noWaitRetCode)
+{
+    if (waitTicks == TASK_NO_WAIT)
     {
-        taskYield();
+        return noWaitRetCode;
     }
+
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    taskQueueAdd(pWaitQueue, &currentTask->waitNode);
+
+    /*Block current task before exiting the critical section, so that the other end cannot make it ready before it is
+    blocked*/
+    taskBlockUnlocked(currentTask, blockedReason, waitTicks);
+
+    EXIT_CRITICAL_SECTION();
+
+    /*Give CPU to other tasks while waiting*/
+    taskYield();
+
+    ENTER_CRITICAL_SECTION();
+
+    /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+    taskQueueRemove(pWaitQueue, &currentTask->waitNode);
+
+    return (currentTask->wakeupReason == WAIT_TIMEOUT) ? RET_TIMEOUT : RET_SUCCESS;
 }
 
 /**
- * @brief  Get an item from the queue buffer
+ * @brief Insert an item to the queue buffer and unblock the next waiting consumer. This function must be called from
+ * within a critical section.
  *
  * @param pQueueHandle
  * @param pItem
+ * @retval true if context switch is required
+ * @retval false otherwise
  */
-static void msgQueueBufferRead(msgQueueHandleType *pQueueHandle, void *pItem)
+static bool msgQueueBufferWrite(msgQueueHandleType *pQueueHandle, void *pItem)
 {
-    bool contextSwitchRequired = false;
+    memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex], pItem, pQueueHandle->itemSize);
+    pQueueHandle->writeIndex = (pQueueHandle->writeIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
+    pQueueHandle->itemCount++;
 
-    taskHandleType *producer = NULL;
+    // Unblock next waiting consumer task
+    bool contextSwitchRequired = msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
 
-    ENTER_CRITICAL_SECTION();
+    /*Pass the wakeup on to the next waiting producer if space is still available, e.g. after a batch was received*/
+    if (msgQueueWritable(pQueueHandle))
+    {
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+    }
+
+    return contextSwitchRequired;
+}
 
+/**
+ * @brief  Get an item from the queue buffer and unblock the next waiting producer. This function must be called from
+ * within a critical section.
+ *
+ * @param pQueueHandle
+ * @param pItem
+ * @retval true if context switch is required
+ * @retval false otherwise
+ */
+static bool msgQueueBufferRead(msgQueueHandleType *pQueueHandle, void *pItem)
+{
     memcpy(pItem, &pQueueHandle->buffer[pQueueHandle->readIndex], pQueueHandle->itemSize);
     pQueueHandle->readIndex = (pQueueHandle->readIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
     pQueueHandle->itemCount--;
 
-    // Get next waiting producer task to unblock
-getNextProducer:
-    producer = taskQueueGet(&pQueueHandle->producerWaitQueue);
-    if (producer != NULL)
+    // Unblock next waiting producer task
+    bool contextSwitchRequired = msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+
+    /*Pass the wakeup on to the next waiting consumer if data is still available, e.g. after a batch was sent*/
+    if (msgQueueReadable(pQueueHandle))
     {
-        /*If task was suspended while waiting for Queue space, skip the task and get another waiting task from the wait Queue*/
-        if (producer->status == TASK_STATUS_SUSPENDED)
-        {
-            goto getNextProducer;
-        }
-        taskSetReady(producer, MSG_QUEUE_SPACE_AVAILABE);
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
+    }
 
-        /*Perform context switch if unblocked producer task has equal or
-         *higher priority[lower priority value] than that of current task */
-        if (producer->priority <= taskPool.currentTask->priority)
-        {
-            contextSwitchRequired = true;
-        }
+    return contextSwitchRequired;
+}
+
+/**
+ * @brief Copy items into the queue buffer at writeIndex, in at most two segments as the ring wraps around, and advance
+ * writeIndex. This function must be called from within a critical section with space for the items.
+ *
+ * @param pQueueHandle
+ * @param pItems
+ * @param count Number of items
+ */
+static void msgQueueBufferCopyIn(msgQueueHandleType *pQueueHandle, const uint8_t *pItems, uint32_t count)
+{
+    uint32_t bufferSize = pQueueHandle->queueLength * pQueueHandle->itemSize;
+    uint32_t copySize = count * pQueueHandle->itemSize;
+    uint32_t firstSize = bufferSize - pQueueHandle->writeIndex;
+
+    if (firstSize >= copySize)
+    {
+        memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex], pItems, copySize);
+        pQueueHandle->writeIndex = (firstSize == copySize) ? 0 : pQueueHandle->writeIndex + copySize;
+    }
+    else
+    {
+        memcpy(&pQueueHandle->buffer[pQueueHandle->writeIndex], pItems, firstSize);
+        memcpy(pQueueHandle->buffer, &pItems[firstSize], copySize - firstSize);
+        pQueueHandle->writeIndex = copySize - firstSize;
     }
 
-    EXIT_CRITICAL_SECTION();
+    pQueueHandle->itemCount += count;
+}
 
-    if (contextSwitchRequired)
+/**
+ * @brief Copy items out of the queue buffer at readIndex, in at most two segments as the ring wraps around, and advance
+ * readIndex. This function must be called from within a critical section with the items in the queue.
+ *
+ * @param pQueueHandle
+ * @param pItems
+ * @param count Number of items
+ */
+static void msgQueueBufferCopyOut(msgQueueHandleType *pQueueHandle, uint8_t *pItems, uint32_t count)
+{
+    uint32_t bufferSize = pQueueHandle->queueLength * pQueueHandle->itemSize;
+    uint32_t copySize = count * pQueueHandle->itemSize;
+    uint32_t firstSize = bufferSize - pQueueHandle->readIndex;
+
+    if (firstSize >= copySize)
     {
-        taskYield();
+        memcpy(pItems, &pQueueHandle->buffer[pQueueHandle->readIndex], copySize);
+        pQueueHandle->readIndex = (firstSize == copySize) ? 0 : pQueueHandle->readIndex + copySize;
+    }
+    else
+    {
+        memcpy(pItems, &pQueueHandle->buffer[pQueueHandle->readIndex], firstSize);
+        memcpy(&pItems[firstSize], pQueueHandle->buffer, copySize - firstSize);
+        pQueueHandle->readIndex = copySize - firstSize;
     }
+
+    pQueueHandle->itemCount -= count;
 }
 
 /**
@@ -141,11 +250,15 @@ int msgQueueSend(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t waitTic
 
     int retCode;
 
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
     /*Write to msgQueue buffer if messageQueue is not full*/
 retry:
-    if (!msgQueueFull(pQueueHandle))
+    if (msgQueueWritable(pQueueHandle))
     {
-        msgQueueBufferWrite(pQueueHandle, pItem);
+        contextSwitchRequired = msgQueueBufferWrite(pQueueHandle, pItem);
 
         retCode = RET_SUCCESS;
     }
@@ -157,32 +270,44 @@ retry:
     {
         taskHandleType *currentTask = taskPool.currentTask;
 
-        taskQueueAdd(&pQueueHandle->producerWaitQueue, currentTask);
+        taskQueueAdd(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
 
-        // Block current task and  give CPU to other tasks while waiting for space to be available
-        taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, waitTicks);
+        /*Block current task in the same critical section, so that space cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, waitTicks);
 
-        if (currentTask->wakeupReason == MSG_QUEUE_SPACE_AVAILABE && !msgQueueFull(pQueueHandle))
-        {
-            msgQueueBufferWrite(pQueueHandle, pItem);
+        EXIT_CRITICAL_SECTION();
 
-            retCode = RET_SUCCESS;
-        }
-        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
-        {
+        // Give CPU to other tasks while waiting for space to be available
+        taskYield();
+
+        ENTER_CRITICAL_SECTION();
 
-            /*Wait timed out,remove task from wait Queue.*/
-            taskQueueRemove(&pQueueHandle->producerWaitQueue, currentTask);
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
 
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
             retCode = RET_TIMEOUT;
         }
-        /*Task might have been suspended while waiting for space to be available and later resumed.
-          In this case, retry sending to the msgQueue again */
+        /*Task has been made ready by the other end, or might have been suspended while waiting for space to be
+        available and later resumed. In both cases, retry as the msgQueue might have been accessed by another task
+        meanwhile.*/
         else
         {
             goto retry;
         }
     }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_SEND, pQueueHandle, retCode);
+
     return retCode;
 }
 
@@ -203,10 +328,213 @@ int msgQueueReceive(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t wait
 
     int retCode;
 
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (msgQueueReadable(pQueueHandle))
+    {
+        contextSwitchRequired = msgQueueBufferRead(pQueueHandle, pItem);
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_EMPTY;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        taskQueueAdd(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that data cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_DATA, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        // Give CPU to other tasks while waiting for data to be available
+        taskYield();
+
+        ENTER_CRITICAL_SECTION();
+
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            retCode = RET_TIMEOUT;
+        }
+        /*Task has been made ready by the other end, or might have been suspended while waiting for data to be
+        available and later resumed. In both cases, retry as the msgQueue might have been accessed by another task
+        meanwhile.*/
+        else
+        {
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_RECEIVE, pQueueHandle, retCode);
+
+    return retCode;
+}
+
+/**
+ * @brief Reserve the next free slot of the queue, so that an item can be written directly into the slot, e.g. by DMA,
+ * instead of being copied from a buffer. The item becomes visible to consumers only when msgQueueCommit is called. Only
+ * one slot can be reserved at a time; other producers wait, or get RET_FULL, until the reserved slot is committed.
+ * If calling this function from an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param ppSlot Pointer to store pointer to the reserved slot of itemSize bytes.
+ * @param waitTicks Number of ticks to wait if Queue is full or a slot is already reserved.
+ * @retval RET_SUCCESS if slot reserved successfully.
+ * @retval RET_FULL if Queue is full or a slot is already reserved.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueueReserve(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(ppSlot != NULL);
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (msgQueueWritable(pQueueHandle))
+    {
+        pQueueHandle->writeReserved = true;
+
+        *ppSlot = &pQueueHandle->buffer[pQueueHandle->writeIndex];
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_FULL;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        taskQueueAdd(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that space cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        // Give CPU to other tasks while waiting for space to be available
+        taskYield();
+
+        ENTER_CRITICAL_SECTION();
+
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            retCode = RET_TIMEOUT;
+        }
+        /*Space available, or task suspended while waiting and later resumed. Retry reserving in both cases.*/
+        else
+        {
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Commit the item written into the slot reserved with msgQueueReserve. The item is added to the queue and a
+ * consumer waiting for data is made ready.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @retval RET_SUCCESS if item committed successfully.
+ * @retval RET_INVAL if no slot is reserved.
+ */
+int msgQueueCommit(msgQueueHandleType *pQueueHandle)
+{
+    assert(pQueueHandle != NULL);
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (!pQueueHandle->writeReserved)
+    {
+        EXIT_CRITICAL_SECTION();
+
+        return RET_INVAL;
+    }
+
+    pQueueHandle->writeReserved = false;
+    pQueueHandle->writeIndex = (pQueueHandle->writeIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
+    pQueueHandle->itemCount++;
+
+    if (msgQueueReadable(pQueueHandle))
+    {
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
+    }
+
+    /*Producers waiting for the reservation to end can write now*/
+    if (msgQueueWritable(pQueueHandle))
+    {
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_SEND, pQueueHandle, RET_SUCCESS);
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Borrow the front item of the queue, so that it can be processed directly in its slot instead of being copied
+ * to a buffer. The item remains in the queue until msgQueueRelease is called. Only one item can be borrowed at a time;
+ * other consumers wait, or get RET_EMPTY, until the borrowed item is released.
+ * If calling this function from an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param ppSlot Pointer to store pointer to the slot holding the front item.
+ * @param waitTicks Number of ticks to wait if Queue is empty or an item is already borrowed.
+ * @retval RET_SUCCESS if item borrowed successfully.
+ * @retval RET_EMPTY if Queue is empty or an item is already borrowed.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueuePeekBorrow(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(ppSlot != NULL);
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
 retry:
-    if (!msgQueueEmpty(pQueueHandle))
+    if (msgQueueReadable(pQueueHandle))
     {
-        msgQueueBufferRead(pQueueHandle, pItem);
+        pQueueHandle->readBorrowed = true;
+
+        *ppSlot = &pQueueHandle->buffer[pQueueHandle->readIndex];
+
         retCode = RET_SUCCESS;
     }
     else if (waitTicks == TASK_NO_WAIT)
@@ -217,31 +545,278 @@ retry:
     {
         taskHandleType *currentTask = taskPool.currentTask;
 
-        taskQueueAdd(&pQueueHandle->consumerWaitQueue, currentTask);
+        taskQueueAdd(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that data cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_DATA, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        // Give CPU to other tasks while waiting for data to be available
+        taskYield();
 
-        // Block current task and give CPU to other tasks while waiting for data to be available
-        taskBlock(currentTask, WAIT_FOR_MSG_QUEUE_DATA, waitTicks);
+        ENTER_CRITICAL_SECTION();
 
-        if (currentTask->wakeupReason == MSG_QUEUE_DATA_AVAILABLE && !msgQueueEmpty(pQueueHandle))
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            retCode = RET_TIMEOUT;
+        }
+        /*Data available, or task suspended while waiting and later resumed. Retry borrowing in both cases.*/
+        else
         {
-            msgQueueBufferRead(pQueueHandle, pItem);
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Release the item borrowed with msgQueuePeekBorrow. The item is removed from the queue and a producer waiting
+ * for space is made ready.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @retval RET_SUCCESS if item released successfully.
+ * @retval RET_INVAL if no item is borrowed.
+ */
+int msgQueueRelease(msgQueueHandleType *pQueueHandle)
+{
+    assert(pQueueHandle != NULL);
 
-            retCode = RET_SUCCESS;
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (!pQueueHandle->readBorrowed)
+    {
+        EXIT_CRITICAL_SECTION();
+
+        return RET_INVAL;
+    }
+
+    pQueueHandle->readBorrowed = false;
+    pQueueHandle->readIndex = (pQueueHandle->readIndex + pQueueHandle->itemSize) % (pQueueHandle->queueLength * pQueueHandle->itemSize);
+    pQueueHandle->itemCount--;
+
+    if (msgQueueWritable(pQueueHandle))
+    {
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+    }
+
+    /*Consumers waiting for the borrowed item to be released can read now*/
+    if (msgQueueReadable(pQueueHandle))
+    {
+        contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_RECEIVE, pQueueHandle, RET_SUCCESS);
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Send up to count items to the queue in a single critical section. Items are copied in at most two memcpy calls
+ * and at most one waiting consumer is made ready per call. If the queue is full, block the task for specified number
+ * of wait ticks until space for at least one item is available. Interrupts stay disabled while the items are copied;
+ * hence, count should be bounded if interrupt latency matters. If calling this function from an ISR, the parameter
+ * waitTicks should be set to TASK_NO_WAIT.
+ * @param pQueueHandle Pointer to queueHandle struct.
+ * @param pItems Pointer to the array of items to be sent to the Queue.
+ * @param count Number of items in the array.
+ * @param waitTicks Number of ticks to wait if Queue is full.
+ * @retval Number of items sent[1 to count], or 0 if count is 0.
+ * @retval RET_FULL if Queue is full.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueueSendN(msgQueueHandleType *pQueueHandle, const void *pItems, uint32_t count, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(pItems != NULL || count == 0);
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    int retCode;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (msgQueueWritable(pQueueHandle))
+    {
+        uint32_t sendCount = pQueueHandle->queueLength - pQueueHandle->itemCount;
+
+        if (sendCount > count)
+        {
+            sendCount = count;
+        }
+
+        msgQueueBufferCopyIn(pQueueHandle, (const uint8_t *)pItems, sendCount);
+
+        // Unblock next waiting consumer task. It passes the wakeup on while data remains.
+        contextSwitchRequired = msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
+
+        /*Pass the wakeup on to the next waiting producer if space is still available*/
+        if (msgQueueWritable(pQueueHandle))
+        {
+            contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
         }
-        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
+
+        retCode = (int)sendCount;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_FULL;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        taskQueueAdd(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that space cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_SPACE, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        // Give CPU to other tasks while waiting for space to be available
+        taskYield();
+
+        ENTER_CRITICAL_SECTION();
+
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->producerWaitQueue, &currentTask->waitNode);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            retCode = RET_TIMEOUT;
+        }
+        /*Space available, or task suspended while waiting and later resumed. Retry sending in both cases.*/
+        else
+        {
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_SEND, pQueueHandle, retCode);
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Receive up to count items from the queue in a single critical section. Items are copied in at most two memcpy
+ * calls and at most one waiting producer is made ready per call. If the queue is empty, block the task for specified
+ * number of wait ticks until at least one item is available. Interrupts stay disabled while the items are copied;
+ * hence, count should be bounded if interrupt latency matters. If calling this function from an ISR, the parameter
+ * waitTicks should be set to TASK_NO_WAIT.
+ * @param pQueueHandle Pointer to queueHandle struct
+ * @param pItems Pointer to the array to be assigned the items received from the Queue.
+ * @param count Maximum number of items to receive.
+ * @param waitTicks Number of ticks to wait if Queue is empty.
+ * @retval Number of items received[1 to count], or 0 if count is 0.
+ * @retval RET_EMPTY if Queue is empty.
+ * @retval RET_TIMEOUT if wait timeout occured.
+ */
+int msgQueueReceiveN(msgQueueHandleType *pQueueHandle, void *pItems, uint32_t count, uint32_t waitTicks)
+{
+    assert(pQueueHandle != NULL);
+    assert(pItems != NULL || count == 0);
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    int retCode;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (msgQueueReadable(pQueueHandle))
+    {
+        uint32_t receiveCount = (pQueueHandle->itemCount < count) ? pQueueHandle->itemCount : count;
+
+        msgQueueBufferCopyOut(pQueueHandle, (uint8_t *)pItems, receiveCount);
+
+        // Unblock next waiting producer task. It passes the wakeup on while space remains.
+        contextSwitchRequired = msgQueueWakeup(&pQueueHandle->producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE);
+
+        /*Pass the wakeup on to the next waiting consumer if data is still available*/
+        if (msgQueueReadable(pQueueHandle))
         {
+            contextSwitchRequired |= msgQueueWakeup(&pQueueHandle->consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE);
+        }
 
-            /*Wait timed out,remove task from wait Queue.*/
-            taskQueueRemove(&pQueueHandle->consumerWaitQueue, currentTask);
+        retCode = (int)receiveCount;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_EMPTY;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        taskQueueAdd(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that data cannot become available before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MSG_QUEUE_DATA, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        // Give CPU to other tasks while waiting for data to be available
+        taskYield();
 
+        ENTER_CRITICAL_SECTION();
+
+        /*Remove task from the wait Queue(if still there), as its queue node will be re-used.*/
+        taskQueueRemove(&pQueueHandle->consumerWaitQueue, &currentTask->waitNode);
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
             retCode = RET_TIMEOUT;
         }
-        /*Task might have been suspended while waiting for data to be available and later resumed.
-        In this case, retry receiving from the msgQueue again */
+        /*Data available, or task suspended while waiting and later resumed. Retry receiving in both cases.*/
         else
         {
             goto retry;
         }
     }
+
+    EXIT_CRITICAL_SECTION();
+
+    TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_RECEIVE, pQueueHandle, retCode);
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
     return retCode;
 }
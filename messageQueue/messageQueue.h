@@ -28,7 +28,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "mutex/mutex.h"
+#include "task/task.h"
 #include "taskQueue/taskQueue.h"
+#include "trace/trace.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -53,7 +55,123 @@ extern "C"
         .itemSize = item_size,                    \
         .itemCount = 0,                           \
         .readIndex = 0,                           \
-        .writeIndex = 0}
+        .writeIndex = 0,                          \
+        .writeReserved = false,                   \
+        .readBorrowed = false}
+
+/**
+ * @brief Declare a message queue of items of a fixed type and a power of 2 length, and its functions
+ * name##Send(const item_type *pItem, uint32_t waitTicks), name##Receive(item_type *pItem, uint32_t waitTicks) and
+ * name##Count(). These functions are specialized at compile time: ring indices wrap around by masking and items are
+ * copied by assignment, i.e. with moves of constant size, instead of modulo and memcpy of a run time size as in
+ * msgQueueSend and msgQueueReceive. Use in a header to share the message queue among source files.
+ * @param name Name of the message queue.
+ * @param length Maximum number of message items the message queue can hold. Must be a power of 2.
+ * @param item_type Type of a message item.
+ */
+#define MSG_QUEUE_TYPED_DECLARE(name, length, item_type)                                                \
+    typedef char name##LengthCheck[(((length) & ((length) - 1)) == 0 && (length) != 0) ? 1 : -1];       \
+    extern item_type name##Buffer[length];                                                              \
+    extern msgQueueTypedHandleType name;                                                                \
+                                                                                                        \
+    static inline uint32_t name##Count()                                                                \
+    {                                                                                                   \
+        return name.writeCount - name.readCount;                                                        \
+    }                                                                                                   \
+                                                                                                        \
+    static inline int name##Send(const item_type *pItem, uint32_t waitTicks)                            \
+    {                                                                                                   \
+        ENTER_CRITICAL_SECTION();                                                                       \
+                                                                                                        \
+        while (name.writeCount - name.readCount == (length))                                            \
+        {                                                                                               \
+            int retCode = msgQueueTypedWait(&name.producerWaitQueue, WAIT_FOR_MSG_QUEUE_SPACE,          \
+                                            waitTicks, RET_FULL);                                       \
+            if (retCode != RET_SUCCESS)                                                                 \
+            {                                                                                           \
+                EXIT_CRITICAL_SECTION();                                                                \
+                TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_SEND, &name, retCode);                                \
+                return retCode;                                                                         \
+            }                                                                                           \
+        }                                                                                               \
+                                                                                                        \
+        name##Buffer[name.writeCount & ((length) - 1)] = *pItem;                                        \
+        name.writeCount++;                                                                              \
+                                                                                                        \
+        bool contextSwitchRequired = !taskQueueEmpty(&name.consumerWaitQueue) &&                        \
+                                     msgQueueWakeup(&name.consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE); \
+                                                                                                        \
+        if (name.writeCount - name.readCount != (length) && !taskQueueEmpty(&name.producerWaitQueue))   \
+        {                                                                                               \
+            contextSwitchRequired |= msgQueueWakeup(&name.producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE); \
+        }                                                                                               \
+                                                                                                        \
+        EXIT_CRITICAL_SECTION();                                                                        \
+                                                                                                        \
+        TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_SEND, &name, RET_SUCCESS);                                    \
+                                                                                                        \
+        if (contextSwitchRequired)                                                                      \
+        {                                                                                               \
+            taskYield();                                                                                \
+        }                                                                                               \
+                                                                                                        \
+        return RET_SUCCESS;                                                                             \
+    }                                                                                                   \
+                                                                                                        \
+    static inline int name##Receive(item_type *pItem, uint32_t waitTicks)                               \
+    {                                                                                                   \
+        ENTER_CRITICAL_SECTION();                                                                       \
+                                                                                                        \
+        while (name.writeCount == name.readCount)                                                       \
+        {                                                                                               \
+            int retCode = msgQueueTypedWait(&name.consumerWaitQueue, WAIT_FOR_MSG_QUEUE_DATA,           \
+                                            waitTicks, RET_EMPTY);                                      \
+            if (retCode != RET_SUCCESS)                                                                 \
+            {                                                                                           \
+                EXIT_CRITICAL_SECTION();                                                                \
+                TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_RECEIVE, &name, retCode);                             \
+                return retCode;                                                                         \
+            }                                                                                           \
+        }                                                                                               \
+                                                                                                        \
+        *pItem = name##Buffer[name.readCount & ((length) - 1)];                                         \
+        name.readCount++;                                                                               \
+                                                                                                        \
+        bool contextSwitchRequired = !taskQueueEmpty(&name.producerWaitQueue) &&                        \
+                                     msgQueueWakeup(&name.producerWaitQueue, MSG_QUEUE_SPACE_AVAILABE); \
+                                                                                                        \
+        if (name.writeCount != name.readCount && !taskQueueEmpty(&name.consumerWaitQueue))              \
+        {                                                                                               \
+            contextSwitchRequired |= msgQueueWakeup(&name.consumerWaitQueue, MSG_QUEUE_DATA_AVAILABLE); \
+        }                                                                                               \
+                                                                                                        \
+        EXIT_CRITICAL_SECTION();                                                                        \
+                                                                                                        \
+        TRACE_EVENT(TRACE_EVENT_MSG_QUEUE_RECEIVE, &name, RET_SUCCESS);                                 \
+                                                                                                        \
+        if (contextSwitchRequired)                                                                      \
+        {                                                                                               \
+            taskYield();                                                                                \
+        }                                                                                               \
+                                                                                                        \
+        return RET_SUCCESS;                                                                             \
+    }
+
+/**
+ * @brief Statically define and initialize a message queue of items of a fixed type and a power of 2 length.
+ * MSG_QUEUE_TYPED_DECLARE with the same arguments must precede it in the source file. The run time sized msgQueue
+ * functions must not be used with this message queue.
+ * @param name Name of the message queue.
+ * @param length Maximum number of message items the message queue can hold. Must be a power of 2.
+ * @param item_type Type of a message item.
+ */
+#define MSG_QUEUE_TYPED_DEFINE(name, length, item_type) \
+    item_type name##Buffer[length];                     \
+    msgQueueTypedHandleType name = {                    \
+        .producerWaitQueue = {0},                       \
+        .consumerWaitQueue = {0},                       \
+        .writeCount = 0,                                \
+        .readCount = 0}
 
     typedef struct
     {
@@ -65,8 +183,19 @@ extern "C"
         uint32_t itemCount;
         uint32_t readIndex;
         uint32_t writeIndex;
+        bool writeReserved; // Slot at writeIndex is reserved by msgQueueReserve
+        bool readBorrowed;  // Item at readIndex is borrowed by msgQueuePeekBorrow
     } msgQueueHandleType;
 
+    /*Handle of a message queue defined with MSG_QUEUE_TYPED_DEFINE. Indices are free running counts of items.*/
+    typedef struct
+    {
+        taskQueueType producerWaitQueue;
+        taskQueueType consumerWaitQueue;
+        uint32_t writeCount;
+        uint32_t readCount;
+    } msgQueueTypedHandleType;
+
     /**
      * @brief Check if message queue is full
      *
@@ -95,6 +224,22 @@ extern "C"
 
     int msgQueueReceive(msgQueueHandleType *pQueueHandle, void *pItem, uint32_t waitTicks);
 
+    bool msgQueueWakeup(taskQueueType *pWaitQueue, wakeupReasonType wakeupReason);
+
+    int msgQueueTypedWait(taskQueueType *pWaitQueue, blockedReasonType blockedReason, uint32_t waitTicks, int noWaitRetCode);
+
+    int msgQueueSendN(msgQueueHandleType *pQueueHandle, const void *pItems, uint32_t count, uint32_t waitTicks);
+
+    int msgQueueReceiveN(msgQueueHandleType *pQueueHandle, void *pItems, uint32_t count, uint32_t waitTicks);
+
+    int msgQueueReserve(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks);
+
+    int msgQueueCommit(msgQueueHandleType *pQueueHandle);
+
+    int msgQueuePeekBorrow(msgQueueHandleType *pQueueHandle, void **ppSlot, uint32_t waitTicks);
+
+    int msgQueueRelease(msgQueueHandleType *pQueueHandle);
+
 #ifdef __cplusplus
 }
 #endif
@@ -28,9 +28,77 @@
 #include "retCodes.h"
 #include "task/task.h"
 #include "scheduler/scheduler.h"
+#include "trace/trace.h"
 #include "taskQueue/taskQueue.h"
 #include "mutex.h"
 
+#if defined(__ARM_FEATURE_LDREX) && (__ARM_FEATURE_LDREX & 4)
+/*Uncontended mutexes are locked and unlocked with LDREX/STREX on ownerTask, without entering critical section. An
+exception entry or return clears the exclusive monitor; hence, a store conditional fails if another task or an ISR
+might have run since the exclusive load, and everything checked in between is still valid when it succeeds.*/
+#define MUTEX_FAST_PATH 1
+
+/**
+ * @brief Lock the mutex if it is unlocked, without entering critical section
+ *
+ * @param pMutex Pointer to the mutex structure
+ * @param currentTask Pointer to taskHandle struct of the current task
+ * @retval true if mutex locked successfully
+ * @retval false if mutex is locked
+ */
+static inline bool mutexLockFast(mutexHandleType *pMutex, taskHandleType *currentTask)
+{
+    volatile uint32_t *pOwner = (volatile uint32_t *)&pMutex->ownerTask;
+
+    do
+    {
+        if (__LDREXW(pOwner) != 0)
+        {
+            __CLREX();
+
+            return false;
+        }
+    } while (__STREXW((uintptr_t)currentTask, pOwner) != 0);
+
+    /*Accesses protected by the mutex must not be performed before it is locked*/
+    __DMB();
+
+    return true;
+}
+
+/**
+ * @brief Unlock the mutex owned by the current task without entering critical section, if no task is waiting for
+ * it and priority of the current task has not been raised by priority inheritance.
+ *
+ * @param pMutex Pointer to the mutex structure
+ * @param currentTask Pointer to taskHandle struct of the current task
+ * @retval true if mutex unlocked successfully
+ * @retval false if mutex must be unlocked in critical section
+ */
+static inline bool mutexUnlockFast(mutexHandleType *pMutex, taskHandleType *currentTask)
+{
+    volatile uint32_t *pOwner = (volatile uint32_t *)&pMutex->ownerTask;
+
+    /*Accesses protected by the mutex must be completed before it is unlocked*/
+    __DMB();
+
+    do
+    {
+        if (__LDREXW(pOwner) != (uintptr_t)currentTask || !taskQueueEmpty(&pMutex->waitQueue) ||
+            pMutex->ownerDefaultPriority != -1)
+        {
+            __CLREX();
+
+            return false;
+        }
+    } while (__STREXW(0, pOwner) != 0);
+
+    return true;
+}
+#else
+#define MUTEX_FAST_PATH 0
+#endif
+
 /**
  * @brief Lock/acquire the mutex. Because mutexes incorporate ownership control and
  * priority inheritance, calling this function from an ISR is not allowed.
@@ -46,10 +114,19 @@ int mutexLock(mutexHandleType *pMutex, uint32_t waitTicks)
 
     int retCode;
 
-    ENTER_CRITICAL_SECTION();
-
     taskHandleType *currentTask = taskPool.currentTask;
 
+#if (MUTEX_FAST_PATH)
+    if (mutexLockFast(pMutex, currentTask))
+    {
+        TRACE_EVENT(TRACE_EVENT_MUTEX_LOCK, pMutex, RET_SUCCESS);
+
+        return RET_SUCCESS;
+    }
+#endif
+
+    ENTER_CRITICAL_SECTION();
+
 retry:
 #if MUTEX_USE_PRIORITY_INHERITANCE
     /* Priority inheritance*/
@@ -60,19 +137,18 @@ retry:
         {
             pMutex->ownerDefaultPriority = pMutex->ownerTask->priority;
         }
-        pMutex->ownerTask->priority = currentTask->priority;
+        taskPrioritySet(pMutex->ownerTask, currentTask->priority);
     }
 #endif
     /* Check if mutex is free and no owner has been assigned. If so, lock mutex immediately.*/
-    if (!pMutex->locked)
+    if (pMutex->ownerTask == NULL)
     {
-        pMutex->locked = true;
         pMutex->ownerTask = currentTask;
 
         retCode = RET_SUCCESS;
     }
 
-    else if (waitTicks == TASK_NO_WAIT && pMutex->locked)
+    else if (waitTicks == TASK_NO_WAIT)
     {
         retCode = RET_BUSY;
     }
@@ -80,13 +156,15 @@ retry:
     else
     {
         /* Add the tasking waiting on mutex to the wait queue*/
-        taskQueueAdd(&pMutex->waitQueue, currentTask);
+        taskQueueAdd(&pMutex->waitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that the mutex cannot be handed over before the task is blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_MUTEX, waitTicks);
 
-        /*Exit from critical section before blocking the task*/
         EXIT_CRITICAL_SECTION();
 
-        /* Block current task and give CPU to other tasks while waiting for mutex*/
-        taskBlock(currentTask, WAIT_FOR_MUTEX, waitTicks);
+        /*Give CPU to other tasks while waiting for mutex*/
+        taskYield();
 
         /*Re-enter critical section after being unblocked*/
         ENTER_CRITICAL_SECTION();
@@ -98,7 +176,7 @@ retry:
         else if (currentTask->wakeupReason == WAIT_TIMEOUT)
         {
             /*Wait timed out, remove task from  the waitQueue.*/
-            taskQueueRemove(&pMutex->waitQueue, currentTask);
+            taskQueueRemove(&pMutex->waitQueue, &currentTask->waitNode);
 
             retCode = RET_TIMEOUT;
         }
@@ -106,12 +184,17 @@ retry:
           In this case, retry locking the mutex again */
         else
         {
+            /*Remove task from the waitQueue(if still there) before retrying, as its queue node will be re-used.*/
+            taskQueueRemove(&pMutex->waitQueue, &currentTask->waitNode);
+
             goto retry;
         }
     }
 
     EXIT_CRITICAL_SECTION();
 
+    TRACE_EVENT(TRACE_EVENT_MUTEX_LOCK, pMutex, retCode);
+
     return retCode;
 }
 
@@ -134,61 +217,61 @@ int mutexUnlock(mutexHandleType *pMutex)
 
     taskHandleType *nextOwner = NULL;
 
-    ENTER_CRITICAL_SECTION();
-
     taskHandleType *currentTask = taskPool.currentTask;
 
-    /*Unlocking the mutex is possible only if current task owns it*/
-
-    if (pMutex->ownerTask == currentTask)
+#if (MUTEX_FAST_PATH)
+    if (mutexUnlockFast(pMutex, currentTask))
     {
-        if (pMutex->locked)
-        {
+        TRACE_EVENT(TRACE_EVENT_MUTEX_UNLOCK, pMutex, RET_SUCCESS);
 
+        return RET_SUCCESS;
+    }
+#endif
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pMutex->ownerTask == NULL)
+    {
+        retCode = RET_NOTLOCKED;
+    }
+    /*Unlocking the mutex is possible only if current task owns it*/
+    else if (pMutex->ownerTask == currentTask)
+    {
 #if MUTEX_USE_PRIORITY_INHERITANCE
-            /* Assign owner task its default priority if priority inheritance was perforemd while locking the mutex*/
-            if (pMutex->ownerDefaultPriority != -1)
-            {
-                pMutex->ownerTask->priority = pMutex->ownerDefaultPriority;
+        /* Assign owner task its default priority if priority inheritance was perforemd while locking the mutex*/
+        if (pMutex->ownerDefaultPriority != -1)
+        {
+            taskPrioritySet(pMutex->ownerTask, (uint8_t)pMutex->ownerDefaultPriority);
 
-                /* Reset owner defalult priority of mutex*/
-                pMutex->ownerDefaultPriority = -1;
-            }
+            /* Reset owner defalult priority of mutex*/
+            pMutex->ownerDefaultPriority = -1;
+        }
 #endif
-            /* Get next owner of the mutex*/
-        getNextOwner:
-            nextOwner = taskQueueGet(&pMutex->waitQueue);
+        /* Get next owner of the mutex*/
+    getNextOwner:
+        nextOwner = taskQueueGet(&pMutex->waitQueue);
 
-            if (nextOwner != NULL)
+        if (nextOwner != NULL)
+        {
+            /*If task was suspended while waiting for mutex,skip the task and get another waiting task from the waitQueue*/
+            if (nextOwner->status == TASK_STATUS_SUSPENDED)
             {
-                /*If task was suspended while waiting for mutex,skip the task and get another waiting task from the waitQueue*/
-                if (nextOwner->status == TASK_STATUS_SUSPENDED)
-                {
-                    goto getNextOwner;
-                }
-
-                taskSetReady(nextOwner, MUTEX_LOCKED);
-
-                /*Perform context switch if next owner task has equal or
-                 *higher priority[lower priority value] than that of current task */
-                if (nextOwner->priority <= taskPool.currentTask->priority)
-                {
-                    contextSwitchRequired = true;
-                }
+                goto getNextOwner;
             }
-            else
+
+            taskSetReady(nextOwner, MUTEX_LOCKED);
+
+            /*Perform context switch if next owner task has equal or
+             *higher priority[lower priority value] than that of current task */
+            if (nextOwner->priority <= taskPool.currentTask->priority)
             {
-                pMutex->locked = false;
+                contextSwitchRequired = true;
             }
+        }
 
-            pMutex->ownerTask = nextOwner;
+        pMutex->ownerTask = nextOwner;
 
-            retCode = RET_SUCCESS;
-        }
-        else
-        {
-            retCode = RET_NOTLOCKED;
-        }
+        retCode = RET_SUCCESS;
     }
     else
     {
@@ -197,6 +280,8 @@ int mutexUnlock(mutexHandleType *pMutex)
 
     EXIT_CRITICAL_SECTION();
 
+    TRACE_EVENT(TRACE_EVENT_MUTEX_UNLOCK, pMutex, retCode);
+
     if (contextSwitchRequired)
     {
         taskYield();
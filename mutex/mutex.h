@@ -40,19 +40,17 @@ extern "C"
  * @brief Statically define and initialize a mutex.
  * @param name Name of the mutex.
  */
-#define MUTEX_DEFINE(name)          \
-    mutexHandleType name = {        \
-        .waitQueue = {0},           \
-        .ownerTask = NULL,          \
-        .ownerDefaultPriority = -1, \
-        .locked = false}
+#define MUTEX_DEFINE(name)   \
+    mutexHandleType name = { \
+        .waitQueue = {0},    \
+        .ownerTask = NULL,   \
+        .ownerDefaultPriority = -1}
 
     typedef struct
     {
         taskQueueType waitQueue;
-        taskHandleType *ownerTask;
+        taskHandleType *volatile ownerTask; // NULL if the mutex is unlocked. Updated with LDREX/STREX by the fast path.
         int16_t ownerDefaultPriority;
-        bool locked;
 
     } mutexHandleType;
 
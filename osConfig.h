@@ -27,6 +27,8 @@
 
 //#define PLATFORM_STM32
 
+/*Only the configuration macros are visible to assembly sources including this file*/
+#ifndef __ASSEMBLER__
 #include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
@@ -36,10 +38,15 @@
 #elif defined(PLATFORM_STM32)
 #include "stm32f4xx_hal.h"
 #endif
+#if defined(PLATFORM_POSIX)
+#include "port/posix/posixPort.h" // Emulation of the CMSIS functions used by the kernel on a Linux host
+#else
 #include "cmsis_gcc.h"
+#endif
 #include "retCodes.h"
+#endif
 
-#ifdef __cplusplus
+#if defined(__cplusplus) && !defined(__ASSEMBLER__)
 extern "C"
 {
 #endif
@@ -50,8 +57,93 @@ extern "C"
 
 #define MUTEX_USE_PRIORITY_INHERITANCE 1
 
+#define TASK_PRIORITY_LEVELS 32 // Number of task priority levels[0 to TASK_PRIORITY_LEVELS - 1]. Upto 32 levels keep the ready bitmap to one word.
+
+/*Default time slice in ticks for round-robin scheduling of tasks having the same priority. A running task is moved behind
+ other ready tasks of its priority when its time slice expires. Time slice of a task can be changed with taskTimeSliceSet.
+ 0 disables time slicing; a task then runs until it blocks or yields.*/
+#define TASK_TIME_SLICE_TICKS 10
+
+#define TASK_RELEASE_STATS 0 // Record lateness of the releases of tasks released periodically with taskSleepUntil.
+
+/*Per task run time accounting. Run time of the running task is accumulated at every context switch and tick with the
+ DWT cycle counter, if the core has one[ARMv7-M and ARMv8-M Mainline]. Otherwise, the application provides a free running
+ counter with runtimeCounterRead()[see task.h]. Voluntary and involuntary context switches are counted as well.*/
+#define TASK_RUNTIME_STATS 0
+
+#define TASK_RUNTIME_WINDOW_TICKS 1000 // Length of the window over which CPU usage of tasks is computed
+
+/*Kernel event trace. Context switches, task state changes, mutex, semaphore and msgQueue operations, timer expiries and
+ interrupts are recorded with cycle timestamps into a RAM ring buffer[traceBuffer], which can be dumped and converted to
+ Chrome/Perfetto trace JSON with tools/traceDecode.py. Timestamps are read from DWT cycle counter, if the core has one.
+ Otherwise, the application provides traceTimestampRead()[see trace.h].*/
+#define OS_TRACE 0
+
+#define OS_TRACE_BUFFER_EVENTS 512 // Number of events kept in the trace buffer. Must be a power of 2.
+
+/*Fill unused task stacks with TASK_STACK_PAINT_PATTERN at definition and the main stack[MSP], used by interrupt handlers,
+ when the scheduler starts; the high-water mark of a stack is then found by scanning for the first overwritten word.
+ Main stack is painted between OS_MSP_STACK_LIMIT and OS_MSP_STACK_TOP, the linker script symbols of its bounds.*/
+#define TASK_STACK_PAINTING 0
+
+#define TASK_STACK_PAINT_PATTERN 0xa5a5a5a5
+
+#define OS_MSP_STACK_LIMIT __StackLimit
+
+#define OS_MSP_STACK_TOP __StackTop
+
+/*Keep TASK_STACK_CANARY in the lowest word of each task stack and check it, along with the saved stack pointer, on
+ every context switch in PendSV handler. taskStackOverflowHandler is called for the task whose stack has overflowed.*/
+#define TASK_STACK_OVERFLOW_CHECK 0
+
+#define TASK_STACK_CANARY 0xdeadbeef
+
+/*Number of tasks that can be created at run time with taskCreate. Task control blocks and stacks of these tasks are taken
+ from static pools and returned when the tasks exit or are deleted with taskDelete. 0 disables taskCreate.*/
+#define TASK_POOL_SIZE 0
+
+#define TASK_POOL_STACK_SIZE 1024 // Stack size in bytes of the tasks created with taskCreate
+
+#define TIMER_TASK_STACK_SIZE 1024 // Stack size of the timer task in bytes. Timeout handlers of timers execute on this stack.
+
+#define IDLE_TASK_STACK_SIZE ((OS_TICKLESS_IDLE) ? 384 : 192) // Idle task processes ticks elapsed in tickless idle mode; hence, it needs a larger stack.
+
 #define OS_TICK_INTERVAL_US 1000 // Generate SysTick interrupt every 1ms.
 
+/*Stop periodic SysTick interrupts while only the idle task is ready. SysTick is reprogrammed to fire at
+ the next timer or timeout deadline and the CPU sleeps with WFI until then. Requires TASK_RUN_PRIVILEGED.
+ On STM32, HAL tick must not be driven by SysTick when this is enabled.*/
+#define OS_TICKLESS_IDLE 0
+
+#define OS_TICKLESS_MIN_IDLE_TICKS 2 // Minimum number of idle ticks for which tickless idle mode is entered.
+
+/*High resolution timer. Provides time in CPU cycles and microseconds, and one-shot alarms at sub-tick deadlines used by
+ taskSleepUS and timerStartUS. Requires TASK_RUN_PRIVILEGED. With OS_HR_TIMER_SYSTICK, alarms are generated by splitting
+ the SysTick period at the alarm deadline; hence, on STM32, HAL tick must not be driven by SysTick when this is enabled.
+ Otherwise, the application provides a free running hardware counter with a compare interrupt[see hrTimer.h].*/
+#define OS_HR_TIMER 0
+
+#define OS_HR_TIMER_SYSTICK 1
+
+#define OS_HR_TIMER_MIN_CYCLES 256 // Minimum length in CPU cycles of a SysTick period split for an alarm. Must exceed SysTick interrupt latency.
+
+/*Software timer wheel geometry. Each of the TIMER_WHEEL_LEVELS levels has (1 << TIMER_WHEEL_SLOT_BITS) slots.
+ Timers expiring within (1 << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) ticks are placed directly; longer timers
+ are re-inserted on cascade.*/
+#define TIMER_WHEEL_SLOT_BITS 5
+
+#define TIMER_WHEEL_LEVELS 4
+
+/*Two-Level Segregated Fit(TLSF) heaps[see heap.h] allocate and free variable size blocks in constant time. Each heap
+ keeps 16 free lists per power of 2 of block size, up to (1 << OS_HEAP_MAX_SIZE_LOG2) bytes.*/
+#define OS_HEAP_MAX_SIZE_LOG2 20
+
+/*Replace the newlib heap(malloc, free, calloc and realloc) with a TLSF heap of OS_HEAP_NEWLIB_SIZE bytes. Not available
+ on the POSIX host port, whose C library owns the process heap.*/
+#define OS_HEAP_NEWLIB 0
+
+#define OS_HEAP_NEWLIB_SIZE 16384
+
 #define MS_TO_CPU_TICKS(ms) ((uint32_t)((uint64_t)ms * SystemCoreClock / 1000))
 #define US_TO_CPU_TICKS(us) ((uint32_t)((uint64_t)us * SystemCoreClock / 1000000))
 
@@ -61,7 +153,7 @@ extern "C"
 #define US_TO_OS_TICKS(us) ((uint32_t)(US_TO_CPU_TICKS(us) / OS_INTERVAL_CPU_TICKS))
 #define MS_TO_OS_TICKS(ms) ((uint32_t)(MS_TO_CPU_TICKS(ms) / OS_INTERVAL_CPU_TICKS))
 
-#ifdef __cplusplus
+#if defined(__cplusplus) && !defined(__ASSEMBLER__)
 }
 #endif
 
@@ -0,0 +1,302 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include "osConfig.h"
+#include "scheduler/scheduler.h"
+#include "task/task.h"
+
+#if !(TASK_RUN_PRIVILEGED)
+#error "POSIX port requires TASK_RUN_PRIVILEGED"
+#endif
+
+#if (OS_TICKLESS_IDLE) || (OS_HR_TIMER)
+#error "OS_TICKLESS_IDLE and OS_HR_TIMER are not supported by the POSIX port"
+#endif
+
+extern void SysTick_Handler();
+
+SCB_Type posixSCB = {0};
+
+CoreDebug_Type posixCoreDebug = {0};
+
+static DWT_Type posixDWT = {0};
+
+uint32_t SystemCoreClock = POSIX_CORE_CLOCK_HZ;
+
+static volatile sig_atomic_t irqDisabled = 0; // Emulated PRIMASK
+
+static volatile sig_atomic_t inISR = 0; // Set while the emulated SysTick handler executes
+
+static volatile sig_atomic_t tickPending = 0; // Emulated SysTick pending bit
+
+static void (*volatile pendingIrqHandler)() = NULL; // Handler of the pending emulated peripheral interrupt
+
+static taskHandleType *runningTask = NULL; // Task whose context is currently loaded
+
+/**
+ * @brief Entry point of the ucontext of a task. The task is started from the emulated PendSV handler with interrupts
+ * disabled; hence, interrupts are enabled before executing the task entry function.
+ */
+static void posixTaskEntry()
+{
+    taskHandleType *pTask = runningTask;
+
+    __enable_irq();
+
+    pTask->taskEntry(pTask->params);
+
+    taskExitFunction();
+}
+
+/**
+ * @brief Emulated PendSV handler. Save context of the running task and restore context of nextTask.
+ */
+void PendSV_Handler()
+{
+    SCB->ICSR &= ~SCB_ICSR_PENDSVSET_Msk;
+
+    /*First task started by schedulerStart runs on the stack of the process*/
+    if (runningTask == NULL)
+    {
+        runningTask = currentTask;
+    }
+
+    taskHandleType *pPrevTask = runningTask;
+    taskHandleType *pNextTask = nextTask;
+
+    if (pPrevTask == pNextTask)
+    {
+        return;
+    }
+
+#if (TASK_STACK_OVERFLOW_CHECK)
+    if (pPrevTask->stackBase[0] != TASK_STACK_CANARY)
+    {
+        taskStackOverflowHandler(pPrevTask);
+    }
+#endif
+
+    posixTaskContextType *pPrevContext = (posixTaskContextType *)pPrevTask->stackPointer;
+    posixTaskContextType *pNextContext = (posixTaskContextType *)pNextTask->stackPointer;
+
+    if (!pNextContext->started)
+    {
+        getcontext(&pNextContext->context);
+
+        pNextContext->context.uc_stack.ss_sp = pNextContext->stack;
+        pNextContext->context.uc_stack.ss_size = pNextContext->stackBytes;
+        pNextContext->context.uc_link = NULL;
+
+        /*Task starts with SIGALRM unblocked, even if it is started from the signal handler*/
+        sigemptyset(&pNextContext->context.uc_sigmask);
+
+        makecontext(&pNextContext->context, posixTaskEntry, 0);
+
+        pNextContext->started = true;
+    }
+
+    pPrevContext->started = true;
+
+    runningTask = pNextTask;
+
+    swapcontext(&pPrevContext->context, &pNextContext->context);
+}
+
+/**
+ * @brief Execute pending peripheral interrupt handler, SysTick handler and PendSV handler, as the hardware would once
+ * interrupts are enabled. All are executed with interrupts disabled, so that they are not nested.
+ */
+static void posixServiceInterrupts()
+{
+    while (pendingIrqHandler != NULL || tickPending || (SCB->ICSR & SCB_ICSR_PENDSVSET_Msk))
+    {
+        irqDisabled = 1;
+
+        if (pendingIrqHandler != NULL)
+        {
+            void (*handler)() = pendingIrqHandler;
+
+            pendingIrqHandler = NULL;
+
+            inISR = 1;
+            handler();
+            inISR = 0;
+        }
+
+        if (tickPending)
+        {
+            tickPending = 0;
+
+            inISR = 1;
+            SysTick_Handler();
+            inISR = 0;
+        }
+
+        /*PendSV has the lowest priority; hence, it is executed after SysTick handler*/
+        if (SCB->ICSR & SCB_ICSR_PENDSVSET_Msk)
+        {
+            PendSV_Handler();
+        }
+
+        irqDisabled = 0;
+    }
+}
+
+/**
+ * @brief SIGALRM handler acting as SysTick interrupt.
+ *
+ * @param signal Signal number
+ */
+static void posixTickSignalHandler(int signal)
+{
+    (void)signal;
+
+    tickPending = 1;
+
+    /*Tick is serviced when interrupts are enabled again*/
+    if (irqDisabled || inISR)
+    {
+        return;
+    }
+
+    posixServiceInterrupts();
+}
+
+/**
+ * @brief Emulated __disable_irq. Defer ticks until interrupts are enabled.
+ */
+void __disable_irq()
+{
+    irqDisabled = 1;
+}
+
+/**
+ * @brief Emulated __enable_irq. Service the tick and PendSV which became pending while interrupts were disabled.
+ */
+void __enable_irq()
+{
+    irqDisabled = 0;
+
+    /*Pending interrupts are serviced on exit from the SysTick handler*/
+    if (!inISR)
+    {
+        posixServiceInterrupts();
+    }
+}
+
+/**
+ * @brief Emulated __get_PRIMASK.
+ *
+ * @return 1 if interrupts are disabled, 0 otherwise
+ */
+uint32_t __get_PRIMASK()
+{
+    return irqDisabled ? 1 : 0;
+}
+
+/**
+ * @brief Emulated __set_PRIMASK.
+ *
+ * @param priMask 1 to disable interrupts, 0 to enable them
+ */
+void __set_PRIMASK(uint32_t priMask)
+{
+    if (priMask & 1)
+    {
+        __disable_irq();
+    }
+    else
+    {
+        __enable_irq();
+    }
+}
+
+/**
+ * @brief Raise an emulated peripheral interrupt, like pending an interrupt in NVIC. The handler executes in interrupt
+ * context as soon as interrupts are enabled; hence, kernel functions callable from ISRs can be exercised on the host.
+ *
+ * @param handler Interrupt handler
+ */
+void posixInterruptRaise(void (*handler)())
+{
+    pendingIrqHandler = handler;
+
+    if (!irqDisabled && !inISR)
+    {
+        posixServiceInterrupts();
+    }
+}
+
+/**
+ * @brief Get emulated DWT. Cycle counter is updated from the monotonic clock on every access.
+ *
+ * @return Pointer to the emulated DWT
+ */
+DWT_Type *posixDWTGet()
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    posixDWT.CYCCNT = (uint32_t)(((uint64_t)now.tv_sec * 1000000000 + now.tv_nsec) * (SystemCoreClock / 1000000) / 1000);
+
+    return &posixDWT;
+}
+
+/**
+ * @brief Emulated SysTick_Config. Start an interval timer raising SIGALRM every specified number of cycles.
+ *
+ * @param ticks Number of CPU cycles between two SysTick interrupts
+ * @retval 0 if timer started successfully
+ * @retval 1 otherwise
+ */
+uint32_t SysTick_Config(uint32_t ticks)
+{
+    struct sigaction action;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = posixTickSignalHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+
+    if (sigaction(SIGALRM, &action, NULL) != 0)
+    {
+        return 1;
+    }
+
+    uint64_t intervalUS = (uint64_t)ticks * 1000000 / SystemCoreClock;
+
+    struct itimerval timerValue = {
+        .it_interval = {.tv_sec = intervalUS / 1000000, .tv_usec = intervalUS % 1000000},
+        .it_value = {.tv_sec = intervalUS / 1000000, .tv_usec = intervalUS % 1000000}};
+
+    return (setitimer(ITIMER_REAL, &timerValue, NULL) == 0) ? 0 : 1;
+}
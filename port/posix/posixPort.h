@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_POSIX_PORT_H
+#define __SANO_RTOS_POSIX_PORT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <ucontext.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*POSIX port runs the kernel as a single threaded Linux process. Each task runs on its own ucontext, SIGALRM from an
+ interval timer acts as SysTick interrupt and PendSV is emulated by switching ucontexts. Interrupt masking is emulated
+ with a flag; a tick arriving while interrupts are disabled is kept pending until they are enabled again. The CMSIS
+ functions and registers used by the kernel are emulated below, so that the kernel sources build unmodified.*/
+
+#define POSIX_CORE_CLOCK_HZ 1000000000UL // Emulated core clock. One CPU cycle is one nanosecond.
+
+#define POSIX_TASK_MIN_STACK_SIZE 65536 // Minimum task stack size in bytes on the host
+
+/*Stack size of a task on the host*/
+#define POSIX_TASK_STACK_SIZE(stackSize) \
+    (((stackSize) > POSIX_TASK_MIN_STACK_SIZE) ? (stackSize) : POSIX_TASK_MIN_STACK_SIZE)
+
+#define __WEAK __attribute__((weak))
+#define __STATIC_INLINE static inline
+
+    typedef enum
+    {
+        PendSV_IRQn = -2,
+        SysTick_IRQn = -1
+    } IRQn_Type;
+
+    /*Emulated System Control Block. Only the Interrupt Control and State Register is emulated.*/
+    typedef struct
+    {
+        volatile uint32_t ICSR;
+    } SCB_Type;
+
+#define SCB_ICSR_PENDSVSET_Msk (1UL << 28)
+#define SCB_ICSR_PENDSTSET_Msk (1UL << 26)
+
+    extern SCB_Type posixSCB;
+
+#define SCB (&posixSCB)
+
+    /*Emulated Data Watchpoint and Trace unit. Cycle counter reads the monotonic clock in emulated CPU cycles.*/
+    typedef struct
+    {
+        volatile uint32_t CTRL;
+        volatile uint32_t CYCCNT;
+    } DWT_Type;
+
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+
+    DWT_Type *posixDWTGet();
+
+#define DWT (posixDWTGet())
+
+    typedef struct
+    {
+        volatile uint32_t DEMCR;
+    } CoreDebug_Type;
+
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+    extern CoreDebug_Type posixCoreDebug;
+
+#define CoreDebug (&posixCoreDebug)
+
+    /*Context of a task on the host*/
+    typedef struct
+    {
+        ucontext_t context;
+        void *stack;
+        size_t stackBytes;
+        bool started; // Set once the context holds a saved or initial state of the task
+    } posixTaskContextType;
+
+    extern uint32_t SystemCoreClock;
+
+    void __disable_irq();
+
+    void __enable_irq();
+
+    uint32_t __get_PRIMASK();
+
+    void __set_PRIMASK(uint32_t priMask);
+
+    uint32_t SysTick_Config(uint32_t ticks);
+
+    void posixInterruptRaise(void (*handler)());
+
+    static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+    {
+        (void)IRQn;
+        (void)priority;
+    }
+
+    static inline void __set_PSP(uintptr_t topOfProcStack)
+    {
+        (void)topOfProcStack;
+    }
+
+    static inline uintptr_t __get_PSP()
+    {
+        return 0;
+    }
+
+    static inline uintptr_t __get_MSP()
+    {
+        return 0;
+    }
+
+    static inline void __BKPT(uint32_t value)
+    {
+        (void)value;
+        __builtin_trap();
+    }
+
+    static inline void __set_CONTROL(uint32_t control)
+    {
+        (void)control;
+    }
+
+    static inline void __set_BASEPRI(uint32_t basePri)
+    {
+        (void)basePri;
+    }
+
+    /*Interrupts are emulated by signal handlers of the same thread; hence, barriers only need to stop the compiler
+    from reordering memory accesses, as the CMSIS barriers do.*/
+    static inline void __ISB() { __asm__ volatile("" ::: "memory"); }
+
+    static inline void __DSB() { __asm__ volatile("" ::: "memory"); }
+
+    static inline void __DMB() { __asm__ volatile("" ::: "memory"); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+#include "osConfig.h"
+#include "task/task.h"
+#include "taskQueue/taskQueue.h"
+#include "readyQueue.h"
+
+#if !defined(__ARM_FEATURE_CLZ)
+/*Number of leading zeros of a 4-bit value. Used on cores without CLZ instruction(ARMv6-M)*/
+static const uint8_t clzLookupTable[16] = {4, 3, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0};
+#endif
+
+/**
+ * @brief Count leading zeros of a non-zero 32-bit value. CLZ instruction is used on ARMv7-M and above,
+ * and a lookup table on ARMv6-M.
+ *
+ * @param value Non-zero value
+ * @return Number of leading zeros
+ */
+static inline uint32_t countLeadingZeros(uint32_t value)
+{
+#if defined(__ARM_FEATURE_CLZ)
+    return __CLZ(value);
+#else
+    uint32_t count = 0;
+
+    if ((value & 0xffff0000UL) == 0)
+    {
+        count += 16;
+        value <<= 16;
+    }
+    if ((value & 0xff000000UL) == 0)
+    {
+        count += 8;
+        value <<= 8;
+    }
+    if ((value & 0xf0000000UL) == 0)
+    {
+        count += 4;
+        value <<= 4;
+    }
+    return count + clzLookupTable[value >> 28];
+#endif
+}
+
+/**
+ * @brief Get the highest priority[lowest priority value] having a non-empty ready list
+ *
+ * @param pReadyQueue Pointer to the non-empty readyQueue struct
+ * @return Highest ready priority
+ */
+static inline uint32_t readyQueueHighestPriority(readyQueueType *pReadyQueue)
+{
+#if (READY_QUEUE_BITMAP_WORDS > 1)
+    uint32_t group = countLeadingZeros(pReadyQueue->groupBitmap);
+
+    return (group << 5) + countLeadingZeros(pReadyQueue->bitmap[group]);
+#else
+    return countLeadingZeros(pReadyQueue->bitmap[0]);
+#endif
+}
+
+/**
+ * @brief Mark ready list of the specified priority as non-empty
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param priority Priority of the ready list
+ */
+static inline void readyQueueBitmapSet(readyQueueType *pReadyQueue, uint32_t priority)
+{
+    pReadyQueue->bitmap[priority >> 5] |= 0x80000000UL >> (priority & 31);
+
+#if (READY_QUEUE_BITMAP_WORDS > 1)
+    pReadyQueue->groupBitmap |= 0x80000000UL >> (priority >> 5);
+#endif
+}
+
+/**
+ * @brief Mark ready list of the specified priority as empty
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param priority Priority of the ready list
+ */
+static inline void readyQueueBitmapClear(readyQueueType *pReadyQueue, uint32_t priority)
+{
+    pReadyQueue->bitmap[priority >> 5] &= ~(0x80000000UL >> (priority & 31));
+
+#if (READY_QUEUE_BITMAP_WORDS > 1)
+    if (pReadyQueue->bitmap[priority >> 5] == 0)
+    {
+        pReadyQueue->groupBitmap &= ~(0x80000000UL >> (priority >> 5));
+    }
+#endif
+}
+
+/**
+ * @brief Add task node to the end of the ready list of its priority.
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
+ */
+void readyQueueAdd(readyQueueType *pReadyQueue, taskNodeType *pTaskNode)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    uint32_t priority = pTaskNode->pTask->priority;
+
+    assert(priority < TASK_PRIORITY_LEVELS);
+
+    readyListType *pReadyList = &pReadyQueue->readyList[priority];
+
+    pTaskNode->nextTaskNode = NULL;
+    pTaskNode->prevTaskNode = pReadyList->tail;
+
+    if (pReadyList->tail == NULL)
+    {
+        pReadyList->head = pTaskNode;
+
+        readyQueueBitmapSet(pReadyQueue, priority);
+    }
+    else
+    {
+        pReadyList->tail->nextTaskNode = pTaskNode;
+    }
+
+    pReadyList->tail = pTaskNode;
+}
+
+/**
+ * @brief Add task node to the front of the ready list of its priority. This is used for a task preempted by a higher
+ * priority task, so that it resumes before other ready tasks of the same priority.
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
+ */
+void readyQueueAddToFront(readyQueueType *pReadyQueue, taskNodeType *pTaskNode)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    uint32_t priority = pTaskNode->pTask->priority;
+
+    assert(priority < TASK_PRIORITY_LEVELS);
+
+    readyListType *pReadyList = &pReadyQueue->readyList[priority];
+
+    pTaskNode->prevTaskNode = NULL;
+    pTaskNode->nextTaskNode = pReadyList->head;
+
+    if (pReadyList->head == NULL)
+    {
+        pReadyList->tail = pTaskNode;
+
+        readyQueueBitmapSet(pReadyQueue, priority);
+    }
+    else
+    {
+        pReadyList->head->prevTaskNode = pTaskNode;
+    }
+
+    pReadyList->head = pTaskNode;
+}
+
+/**
+ * @brief Remove task node from the ready list of its priority.
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
+ */
+void readyQueueRemove(readyQueueType *pReadyQueue, taskNodeType *pTaskNode)
+{
+    assert(pReadyQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    uint32_t priority = pTaskNode->pTask->priority;
+
+    readyListType *pReadyList = &pReadyQueue->readyList[priority];
+
+    if (pTaskNode->prevTaskNode != NULL)
+    {
+        pTaskNode->prevTaskNode->nextTaskNode = pTaskNode->nextTaskNode;
+    }
+    else
+    {
+        pReadyList->head = pTaskNode->nextTaskNode;
+    }
+
+    if (pTaskNode->nextTaskNode != NULL)
+    {
+        pTaskNode->nextTaskNode->prevTaskNode = pTaskNode->prevTaskNode;
+    }
+    else
+    {
+        pReadyList->tail = pTaskNode->prevTaskNode;
+    }
+
+    pTaskNode->nextTaskNode = NULL;
+    pTaskNode->prevTaskNode = NULL;
+
+    if (pReadyList->head == NULL)
+    {
+        readyQueueBitmapClear(pReadyQueue, priority);
+    }
+}
+
+/**
+ * @brief Get the highest priority ready task without removing it from the readyQueue
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @retval Highest priority ready task if exists
+ * @retval NULL if readyQueue is empty
+ */
+taskHandleType *readyQueuePeek(readyQueueType *pReadyQueue)
+{
+    assert(pReadyQueue != NULL);
+
+    if (readyQueueEmpty(pReadyQueue))
+    {
+        return NULL;
+    }
+
+    return pReadyQueue->readyList[readyQueueHighestPriority(pReadyQueue)].head->pTask;
+}
+
+/**
+ * @brief Get the highest priority ready task and remove it from the readyQueue. Tasks having the
+ * same priority are returned in First In First Out(FIFO) order.
+ *
+ * @param pReadyQueue Pointer to the readyQueue struct
+ * @retval Highest priority ready task if exists
+ * @retval NULL if readyQueue is empty
+ */
+taskHandleType *readyQueueGet(readyQueueType *pReadyQueue)
+{
+    assert(pReadyQueue != NULL);
+
+    if (readyQueueEmpty(pReadyQueue))
+    {
+        return NULL;
+    }
+
+    uint32_t priority = readyQueueHighestPriority(pReadyQueue);
+
+    readyListType *pReadyList = &pReadyQueue->readyList[priority];
+
+    taskNodeType *headNode = pReadyList->head;
+
+    pReadyList->head = headNode->nextTaskNode;
+
+    if (pReadyList->head == NULL)
+    {
+        pReadyList->tail = NULL;
+
+        readyQueueBitmapClear(pReadyQueue, priority);
+    }
+    else
+    {
+        pReadyList->head->prevTaskNode = NULL;
+    }
+
+    headNode->nextTaskNode = NULL;
+
+    return headNode->pTask;
+}
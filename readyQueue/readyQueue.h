@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_READY_QUEUE_H
+#define __SANO_RTOS_READY_QUEUE_H
+
+#include "osConfig.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#if (TASK_PRIORITY_LEVELS < 1) || (TASK_PRIORITY_LEVELS > 256)
+#error "TASK_PRIORITY_LEVELS must be in the range 1 to 256"
+#endif
+
+/*Number of 32-bit words required for the ready priority bitmap*/
+#define READY_QUEUE_BITMAP_WORDS ((TASK_PRIORITY_LEVELS + 31) / 32)
+
+    /*FIFO list of ready tasks having the same priority*/
+    typedef struct
+    {
+        taskNodeType *head;
+        taskNodeType *tail;
+    } readyListType;
+
+    /*Queue of ready tasks. Ready tasks are kept in one FIFO list per priority level and a bitmap records
+    which of these lists are non-empty. Bit (31 - priority % 32) of bitmap[priority / 32] is set if the list
+    of that priority is non-empty; hence, the highest priority[lowest priority value] ready task is found by
+    counting leading zeros of the bitmap. With more than 32 priority levels, bit (31 - n) of groupBitmap is
+    set if bitmap[n] is non-zero.*/
+    typedef struct
+    {
+#if (READY_QUEUE_BITMAP_WORDS > 1)
+        uint32_t groupBitmap;
+#endif
+        uint32_t bitmap[READY_QUEUE_BITMAP_WORDS];
+        readyListType readyList[TASK_PRIORITY_LEVELS];
+    } readyQueueType;
+
+    void readyQueueAdd(readyQueueType *pReadyQueue, taskNodeType *pTaskNode);
+
+    void readyQueueAddToFront(readyQueueType *pReadyQueue, taskNodeType *pTaskNode);
+
+    void readyQueueRemove(readyQueueType *pReadyQueue, taskNodeType *pTaskNode);
+
+    taskHandleType *readyQueuePeek(readyQueueType *pReadyQueue);
+
+    taskHandleType *readyQueueGet(readyQueueType *pReadyQueue);
+
+    /**
+     * @brief Check if readyQueue is empty
+     *
+     * @param pReadyQueue Pointer to the readyQueue struct
+     * @retval true if readyQueue is empty
+     * @retval false, otherwise
+     */
+    static inline bool readyQueueEmpty(readyQueueType *pReadyQueue)
+    {
+#if (READY_QUEUE_BITMAP_WORDS > 1)
+        return pReadyQueue->groupBitmap == 0;
+#else
+        return pReadyQueue->bitmap[0] == 0;
+#endif
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "osConfig.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "ringBuffer.h"
+
+/**
+ * @brief Make the consumer blocked in ringBufferRead ready. The consumer is blocked in the same critical section in
+ * which it is added to the wait queue; hence, a consumer found in the wait queue is either blocked or, after a wait
+ * timeout, about to remove itself from the wait queue.
+ *
+ * @param pRingBuffer Pointer to the ringBufferHandle struct
+ */
+static void ringBufferConsumerWakeup(ringBufferHandleType *pRingBuffer)
+{
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    taskHandleType *consumer = taskQueueEmpty(&pRingBuffer->consumerWaitQueue) ? NULL : taskQueuePeek(&pRingBuffer->consumerWaitQueue);
+
+    /*If consumer was suspended while waiting, it reads again once resumed. A consumer deleted while waiting has been
+    removed from the wait queue by taskDelete.*/
+    if (consumer != NULL && consumer->status != TASK_STATUS_SUSPENDED)
+    {
+        taskQueueRemove(&pRingBuffer->consumerWaitQueue, &consumer->waitNode);
+
+        /*Consumer running after a wait timeout, e.g. when written by an ISR, checks for the item itself*/
+        if (consumer != taskPool.currentTask)
+        {
+            taskSetReady(consumer, RING_BUFFER_DATA_AVAILABLE);
+
+            /*Perform context switch if unblocked consumer task has equal or
+             *higher priority[lower priority value] than that of current task */
+            if (consumer->priority <= taskPool.currentTask->priority)
+            {
+                contextSwitchRequired = true;
+            }
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+}
+
+/**
+ * @brief Write an item to the ring buffer. Interrupts are not masked unless the consumer is blocked waiting for an item.
+ * Must be called by a single producer, a task or an ISR.
+ *
+ * @param pRingBuffer Pointer to the ringBufferHandle struct
+ * @param pItem Pointer to the item to write
+ * @retval RET_SUCCESS if item written successfully
+ * @retval RET_FULL if ring buffer is full
+ */
+int ringBufferWrite(ringBufferHandleType *pRingBuffer, const void *pItem)
+{
+    assert(pRingBuffer != NULL);
+    assert(pItem != NULL);
+
+    uint32_t writeCount = pRingBuffer->writeCount;
+
+    if (writeCount - pRingBuffer->readCount > pRingBuffer->lengthMask)
+    {
+        return RET_FULL;
+    }
+
+    memcpy(&pRingBuffer->buffer[(writeCount & pRingBuffer->lengthMask) * pRingBuffer->itemSize], pItem, pRingBuffer->itemSize);
+
+    /*Item must be in the buffer before the consumer sees the updated count*/
+    __DMB();
+
+    pRingBuffer->writeCount = writeCount + 1;
+
+    /*Updated count must be visible before checking for a waiting consumer, which checks the count after publishing itself*/
+    __DMB();
+
+    if (!taskQueueEmpty(&pRingBuffer->consumerWaitQueue))
+    {
+        ringBufferConsumerWakeup(pRingBuffer);
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Read an item from the ring buffer. Interrupts are not masked if an item is available. Otherwise, block the task
+ * for specified number of wait ticks. Must be called by a single consumer. If calling this function from an ISR, the
+ * parameter waitTicks should be set to TASK_NO_WAIT.
+ *
+ * @param pRingBuffer Pointer to the ringBufferHandle struct
+ * @param pItem Pointer to the buffer to copy the item to
+ * @param waitTicks Number of ticks to wait if ring buffer is empty
+ * @retval RET_SUCCESS if item read successfully
+ * @retval RET_EMPTY if ring buffer is empty
+ * @retval RET_TIMEOUT if wait timeout occured
+ */
+int ringBufferRead(ringBufferHandleType *pRingBuffer, void *pItem, uint32_t waitTicks)
+{
+    assert(pRingBuffer != NULL);
+    assert(pItem != NULL);
+
+    uint32_t readCount = pRingBuffer->readCount;
+
+    while (pRingBuffer->writeCount == readCount)
+    {
+        if (waitTicks == TASK_NO_WAIT)
+        {
+            return RET_EMPTY;
+        }
+
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        ENTER_CRITICAL_SECTION();
+
+        taskQueueAdd(&pRingBuffer->consumerWaitQueue, &currentTask->waitNode);
+
+        /*Producer might have written an item before the consumer was published as waiting*/
+        __DMB();
+
+        if (pRingBuffer->writeCount != readCount)
+        {
+            taskQueueRemove(&pRingBuffer->consumerWaitQueue, &currentTask->waitNode);
+
+            EXIT_CRITICAL_SECTION();
+
+            break;
+        }
+
+        /*Block current task in the same critical section as the check above, so that the producer cannot make it
+        ready before it is blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_RING_BUFFER_DATA, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        /* Give CPU to other tasks while waiting for an item*/
+        taskYield();
+
+        /*Consumer is still in the wait queue if woken up by timeout or resume*/
+        ENTER_CRITICAL_SECTION();
+
+        taskQueueRemove(&pRingBuffer->consumerWaitQueue, &currentTask->waitNode);
+
+        EXIT_CRITICAL_SECTION();
+
+        if (currentTask->wakeupReason == WAIT_TIMEOUT && pRingBuffer->writeCount == readCount)
+        {
+            return RET_TIMEOUT;
+        }
+    }
+
+    /*Count must be read before the item*/
+    __DMB();
+
+    memcpy(pItem, &pRingBuffer->buffer[(readCount & pRingBuffer->lengthMask) * pRingBuffer->itemSize], pRingBuffer->itemSize);
+
+    /*Item must be copied before the producer sees its slot free*/
+    __DMB();
+
+    pRingBuffer->readCount = readCount + 1;
+
+    return RET_SUCCESS;
+}
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_RING_BUFFER_H
+#define __SANO_RTOS_RING_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "task/task.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Statically define and initialize a lock-free single producer, single consumer ring buffer. The producer,
+ * typically an ISR, and the consumer, typically a task, each update only their own index; hence, no interrupts are
+ * masked while writing or reading items.
+ * @param name Name of the ring buffer.
+ * @param length Maximum number of items the ring buffer can hold. Must be a power of 2.
+ * @param item_size Size of an item in bytes.
+ */
+#define RING_BUFFER_DEFINE(name, length, item_size)                                               \
+    typedef char name##LengthCheck[(((length) & ((length) - 1)) == 0 && (length) != 0) ? 1 : -1]; \
+    uint8_t name##Buffer[(length) * (item_size)];                                                 \
+    ringBufferHandleType name = {                                                                 \
+        .buffer = name##Buffer,                                                                   \
+        .lengthMask = (length) - 1,                                                               \
+        .itemSize = item_size,                                                                    \
+        .writeCount = 0,                                                                          \
+        .readCount = 0,                                                                           \
+        .consumerWaitQueue = {0}}
+
+    typedef struct
+    {
+        uint8_t *buffer;
+        uint32_t lengthMask; // Ring buffer length - 1
+        uint32_t itemSize;
+        volatile uint32_t writeCount;              // Number of items written. Updated by the producer only.
+        volatile uint32_t readCount;               // Number of items read. Updated by the consumer only.
+        taskQueueType consumerWaitQueue;          // Holds the consumer task blocked waiting for an item
+    } ringBufferHandleType;
+
+    int ringBufferWrite(ringBufferHandleType *pRingBuffer, const void *pItem);
+
+    int ringBufferRead(ringBufferHandleType *pRingBuffer, void *pItem, uint32_t waitTicks);
+
+    /**
+     * @brief Get number of items in the ring buffer
+     *
+     * @param pRingBuffer Pointer to the ringBufferHandle struct
+     * @return Number of items
+     */
+    static inline uint32_t ringBufferCount(ringBufferHandleType *pRingBuffer)
+    {
+        return pRingBuffer->writeCount - pRingBuffer->readCount;
+    }
+
+    /**
+     * @brief Check if ring buffer is empty
+     *
+     * @param pRingBuffer Pointer to the ringBufferHandle struct
+     * @retval true if ring buffer is empty
+     * @retval false otherwise
+     */
+    static inline bool ringBufferEmpty(ringBufferHandleType *pRingBuffer)
+    {
+        return pRingBuffer->writeCount == pRingBuffer->readCount;
+    }
+
+    /**
+     * @brief Check if ring buffer is full
+     *
+     * @param pRingBuffer Pointer to the ringBufferHandle struct
+     * @retval true if ring buffer is full
+     * @retval false otherwise
+     */
+    static inline bool ringBufferFull(ringBufferHandleType *pRingBuffer)
+    {
+        return ringBufferCount(pRingBuffer) > pRingBuffer->lengthMask;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
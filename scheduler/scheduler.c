@@ -22,22 +22,130 @@
  * SOFTWARE.
  */
 
-#include <stdlib.h>
 #include "osConfig.h"
 #include "task/task.h"
 #include "timer/timer.h"
+#include "hrTimer/hrTimer.h"
+#include "trace/trace.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
+#include "timeoutQueue/timeoutQueue.h"
 #include "scheduler.h"
 
 #define IDLE_TASK_PRIORITY TASK_LOWEST_PRIORITY // Idle task has lowest possible priority[higher the value lower the priority]
 
-TASK_DEFINE(idleTask, 192, idleTaskHandler, NULL, IDLE_TASK_PRIORITY);
+#if (OS_TICKLESS_IDLE) && !(TASK_RUN_PRIVILEGED)
+#error "OS_TICKLESS_IDLE requires TASK_RUN_PRIVILEGED"
+#endif
+
+static volatile uint64_t tickCount = 0; // Number of ticks elapsed since the scheduler started
+
+/*Reason for selecting the next task to run*/
+typedef enum
+{
+    SCHEDULE_PREEMPT,           // Running task is preempted only by a higher priority task
+    SCHEDULE_YIELD,             // Running task yields to ready tasks of the same priority
+    SCHEDULE_TIME_SLICE_EXPIRED // Time slice of the running task has expired; it gives CPU to ready tasks of the same priority
+} scheduleReasonType;
+
+#if (TASK_RUNTIME_STATS)
+#if defined(DWT)
+/**
+ * @brief Read DWT cycle counter, used as the run time counter.
+ *
+ * @return Cycle count
+ */
+static inline uint32_t runtimeCounterRead()
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+static uint32_t lastAccountCycles = 0; // Run time counter value when run time was last charged to the running task
+
+static uint32_t runtimeWindowIndex = 0; // Index of the current CPU usage window
+
+static uint32_t runtimeWindowStartCycles = 0; // Run time counter value at the start of the current window
+
+static uint32_t lastRuntimeWindowCycles = 0; // Length of the last complete window
+
+static uint64_t runtimeWindowEndTick = TASK_RUNTIME_WINDOW_TICKS; // Tick at which the current window ends
+#endif
+
+TASK_DEFINE(idleTask, IDLE_TASK_STACK_SIZE, idleTaskHandler, NULL, IDLE_TASK_PRIORITY);
+
+#if (OS_TICKLESS_IDLE)
+static void ticklessIdle();
+#endif
+
+#if (TASK_STACK_PAINTING)
+/*Bounds of the main stack from the linker script. Declared weak, so that MSP painting is skipped if they are undefined.*/
+extern uint32_t OS_MSP_STACK_LIMIT[] __attribute__((weak));
+extern uint32_t OS_MSP_STACK_TOP[] __attribute__((weak));
+
+/**
+ * @brief Paint the unused part of the main stack, below the stack frame of the caller. Called before the scheduler
+ * starts; main stack is used only by interrupt handlers thereafter.
+ */
+static void mspPaint()
+{
+    if (OS_MSP_STACK_LIMIT == NULL || OS_MSP_STACK_TOP == NULL)
+    {
+        return;
+    }
+
+    /*Leave a margin below the current stack pointer for the frame of this function*/
+    uint32_t *pEnd = (uint32_t *)__get_MSP() - 16;
+
+    for (uint32_t *pWord = OS_MSP_STACK_LIMIT; pWord < pEnd; pWord++)
+    {
+        *pWord = TASK_STACK_PAINT_PATTERN;
+    }
+}
+
+/**
+ * @brief Get high-water mark of the main stack[MSP], which is used by main before the scheduler starts and by
+ * interrupt handlers.
+ *
+ * @return Maximum stack usage in bytes. 0 if the bounds of the main stack are not known.
+ */
+uint32_t schedulerMspHighWaterMarkGet()
+{
+    if (OS_MSP_STACK_LIMIT == NULL || OS_MSP_STACK_TOP == NULL)
+    {
+        return 0;
+    }
+
+    uint32_t *pWord = OS_MSP_STACK_LIMIT;
+
+    while (pWord < OS_MSP_STACK_TOP && *pWord == TASK_STACK_PAINT_PATTERN)
+    {
+        pWord++;
+    }
+
+    return (uint32_t)(OS_MSP_STACK_TOP - pWord) * sizeof(uint32_t);
+}
+
+/**
+ * @brief Get high-water mark of the idle task stack.
+ *
+ * @return Maximum stack usage in bytes
+ */
+uint32_t schedulerIdleStackHighWaterMarkGet()
+{
+    return taskStackHighWaterMarkGet(&idleTask);
+}
+#endif
 
 void idleTaskHandler(void *params)
 {
     (void)params;
     while (1)
-        ;
+    {
+#if (OS_TICKLESS_IDLE)
+        ticklessIdle();
+#endif
+    }
 }
 /**
  * @brief Trigger PendSV interrupt
@@ -48,26 +156,143 @@ static inline void triggerPendSV()
     SCB->ICSR |= SCB_ICSR_PENDSVSET_Msk;
 }
 
+#if (TASK_RUNTIME_STATS)
+/**
+ * @brief Move run time of the task in its last window to lastWindowCycles, if a new window has started since the task
+ * was last charged.
+ *
+ * @param pTask Pointer to taskHandle struct
+ */
+static void runtimeWindowSync(taskHandleType *pTask)
+{
+    taskRuntimeType *pRuntime = &pTask->runtime;
+
+    if (pRuntime->windowIndex != runtimeWindowIndex)
+    {
+        pRuntime->lastWindowCycles = (pRuntime->windowIndex + 1 == runtimeWindowIndex) ? pRuntime->windowCycles : 0;
+        pRuntime->windowCycles = 0;
+        pRuntime->windowIndex = runtimeWindowIndex;
+    }
+}
+
+/**
+ * @brief Charge the run time counted since the last charge to the running task. Must be called with interrupts disabled.
+ *
+ * @param pTask Pointer to taskHandle struct of the running task
+ */
+static void runtimeAccount(taskHandleType *pTask)
+{
+    uint32_t now = runtimeCounterRead();
+    uint32_t elapsedCycles = now - lastAccountCycles;
+
+    lastAccountCycles = now;
+
+    runtimeWindowSync(pTask);
+
+    pTask->runtime.runtimeCycles += elapsedCycles;
+    pTask->runtime.windowCycles += elapsedCycles;
+}
+
+/**
+ * @brief Charge run time to the running task and start a new CPU usage window once the current window has elapsed.
+ * Called on every tick; hence, the 32-bit counter is sampled often enough not to wrap around unnoticed.
+ */
+static void runtimeTick()
+{
+    runtimeAccount(taskPool.currentTask);
+
+    if (tickCount >= runtimeWindowEndTick)
+    {
+        /*Window is closed at the tick on which it was detected to elapse; its length is measured, not assumed.*/
+        lastRuntimeWindowCycles = lastAccountCycles - runtimeWindowStartCycles;
+        runtimeWindowStartCycles = lastAccountCycles;
+        runtimeWindowEndTick = tickCount + TASK_RUNTIME_WINDOW_TICKS;
+        runtimeWindowIndex++;
+    }
+}
+
+/**
+ * @brief Get run time statistics of the task.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param pRuntimeStats Pointer to the struct to fill with run time statistics
+ */
+void taskRuntimeStatsGet(taskHandleType *pTask, taskRuntimeStatsType *pRuntimeStats)
+{
+    assert(pTask != NULL);
+    assert(pRuntimeStats != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    /*Include run time of the running task since the last context switch or tick*/
+    if (pTask == taskPool.currentTask)
+    {
+        runtimeAccount(pTask);
+    }
+    else
+    {
+        runtimeWindowSync(pTask);
+    }
+
+    pRuntimeStats->runtimeCycles = pTask->runtime.runtimeCycles;
+    pRuntimeStats->cpuUsage = (lastRuntimeWindowCycles != 0)
+                                  ? (uint32_t)((uint64_t)pTask->runtime.lastWindowCycles * 10000 / lastRuntimeWindowCycles)
+                                  : 0;
+    pRuntimeStats->voluntarySwitchCount = pTask->runtime.voluntarySwitchCount;
+    pRuntimeStats->involuntarySwitchCount = pTask->runtime.involuntarySwitchCount;
+
+    EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Get run time statistics of the idle task. Run time of the idle task is the total idle time and its CPU
+ * usage is the idle percentage.
+ *
+ * @param pRuntimeStats Pointer to the struct to fill with run time statistics
+ */
+void schedulerIdleStatsGet(taskRuntimeStatsType *pRuntimeStats)
+{
+    taskRuntimeStatsGet(&idleTask, pRuntimeStats);
+}
+#endif
+
 /**
  * @brief Select next highest priority ready task for execution and trigger PendSV to perform actual context switch.
+ *
+ * @param reason Reason for scheduling. Unless the running task yields or its time slice has expired, it is preempted
+ * only by a higher priority task.
  */
-static void scheduleNextTask()
+static void scheduleNextTask(scheduleReasonType reason)
 {
-    if (!taskQueueEmpty(&taskPool.readyQueue))
+    if (!readyQueueEmpty(&taskPool.readyQueue))
     {
+        taskHandleType *pCurrentTask = taskPool.currentTask;
+
+        bool involuntarySwitch = false;
 
-        if (taskPool.currentTask->status == TASK_STATUS_RUNNING)
+        if (pCurrentTask->status == TASK_STATUS_RUNNING)
         {
-            /*Perform context switch only if next highest priority ready task has equal or higher priority[lower priority value]
-            than the current running task*/
+            /*Perform context switch only if next highest priority ready task has higher priority[lower priority value]
+            than the current running task, or has the same priority and the current task yields to it*/
+
+            taskHandleType *nextReadyTask = readyQueuePeek(&taskPool.readyQueue);
 
-            taskHandleType *nextReadyTask = taskQueuePeek(&taskPool.readyQueue);
+            if (nextReadyTask->priority < pCurrentTask->priority)
+            {
+                /*Preempted task resumes before other ready tasks of its priority, with the rest of its time slice*/
+                pCurrentTask->status = TASK_STATUS_READY;
+                readyQueueAddToFront(&taskPool.readyQueue, &pCurrentTask->stateNode);
 
-            if (nextReadyTask->priority <= taskPool.currentTask->priority)
+                involuntarySwitch = true;
+            }
+            else if (nextReadyTask->priority == pCurrentTask->priority && reason != SCHEDULE_PREEMPT)
             {
-                /*Change current task's status to ready and add it to the readyQueue*/
-                taskPool.currentTask->status = TASK_STATUS_READY;
-                taskQueueAdd(&taskPool.readyQueue, taskPool.currentTask);
+                /*Change current task's status to ready and add it behind other ready tasks of its priority*/
+                pCurrentTask->status = TASK_STATUS_READY;
+                pCurrentTask->remainingSliceTicks = pCurrentTask->timeSliceTicks;
+                readyQueueAdd(&taskPool.readyQueue, &pCurrentTask->stateNode);
+
+                involuntarySwitch = (reason == SCHEDULE_TIME_SLICE_EXPIRED);
             }
             else
             {
@@ -76,11 +301,34 @@ static void scheduleNextTask()
                 return;
             }
         }
+        else
+        {
+            /*Task has blocked, suspended itself or has already been queued as ready. It gets a new time slice when it runs again.*/
+            pCurrentTask->remainingSliceTicks = pCurrentTask->timeSliceTicks;
+        }
 
-        currentTask = taskPool.currentTask;
+#if (TASK_RUNTIME_STATS)
+        runtimeAccount(pCurrentTask);
+
+        if (involuntarySwitch)
+        {
+            pCurrentTask->runtime.involuntarySwitchCount++;
+        }
+        else
+        {
+            pCurrentTask->runtime.voluntarySwitchCount++;
+        }
+#else
+        (void)involuntarySwitch;
+#endif
+
+        currentTask = pCurrentTask;
 
         // Get the next highest priority  ready task
-        nextTask = taskQueueGet(&taskPool.readyQueue);
+        nextTask = readyQueueGet(&taskPool.readyQueue);
+
+        TRACE_EVENT(TRACE_EVENT_TASK_SWITCH_OUT, pCurrentTask, pCurrentTask->status);
+        TRACE_EVENT(TRACE_EVENT_TASK_SWITCH_IN, nextTask, 0);
 
         taskPool.currentTask = nextTask;
 
@@ -91,34 +339,219 @@ static void scheduleNextTask()
     }
 }
 
+/**
+ * @brief Account a tick to the time slice of the running task.
+ *
+ * @retval true if the time slice of the running task has expired
+ * @retval false, otherwise
+ */
+static bool timeSliceTick()
+{
+    taskHandleType *pCurrentTask = taskPool.currentTask;
+
+    if (pCurrentTask->status != TASK_STATUS_RUNNING || pCurrentTask->timeSliceTicks == 0)
+    {
+        return false;
+    }
+
+    if (--pCurrentTask->remainingSliceTicks != 0)
+    {
+        return false;
+    }
+
+    /*Start a new time slice. Task continues to run if no other task of its priority is ready.*/
+    pCurrentTask->remainingSliceTicks = pCurrentTask->timeSliceTicks;
+
+    return true;
+}
+
 /**
  * @brief Check for timeout of blocked tasks and change  status to READY
  * with corresponding timeout reason.
+ * @param elapsedTicks Number of ticks elapsed since timeouts were last checked
+ */
+static void checkTimeout(uint32_t elapsedTicks)
+{
+    taskHandleType *pTask;
+
+    /*Only the head of the timeoutQueue needs to be updated; deadlines of other tasks are relative to it*/
+    timeoutQueueAdvance(&taskPool.timeoutQueue, elapsedTicks);
+
+    while ((pTask = timeoutQueueGetExpired(&taskPool.timeoutQueue)) != NULL)
+    {
+        if (pTask->blockedReason == SLEEP)
+            taskSetReady(pTask, SLEEP_TIME_TIMEOUT);
+        else
+            taskSetReady(pTask, WAIT_TIMEOUT);
+    }
+}
+
+/**
+ * @brief Process timers and timeouts of blocked tasks for the specified number of elapsed ticks.
+ *
+ * @param elapsedTicks Number of elapsed ticks
+ */
+static void processTicks(uint32_t elapsedTicks)
+{
+    tickCount += elapsedTicks;
+
+#if (TASK_RUNTIME_STATS)
+    runtimeTick();
+#endif
+
+    /*Check for timer timeout*/
+    processTimers(elapsedTicks);
+
+    /*Check for wait timeout of blocked tasks*/
+    if (!timeoutQueueEmpty(&taskPool.timeoutQueue))
+    {
+        checkTimeout(elapsedTicks);
+    }
+}
+
+#if (OS_TICKLESS_IDLE)
+/**
+ * @brief Program SysTick to fire after the specified number of ticks instead of every tick and sleep until then or
+ * until any other interrupt occurs. This function is called by the idle task with interrupts disabled. It is defined
+ * weak, so that it can be overridden to use a low power timer instead of SysTick.
+ *
+ * @param expectedIdleTicks Number of ticks until the next timer or timeout deadline
+ * @return Number of complete ticks elapsed while sleeping and not processed by SysTick handler.
  */
-static void checkTimeout()
+__WEAK uint32_t ticklessIdleSleep(uint32_t expectedIdleTicks)
 {
+    uint32_t tickCycles = OS_INTERVAL_CPU_TICKS;
+    uint32_t maxIdleTicks = SysTick_LOAD_RELOAD_Msk / tickCycles;
+    uint32_t elapsedTicks;
+    uint32_t cyclesToNextTick;
+
+    if (expectedIdleTicks > maxIdleTicks)
+    {
+        expectedIdleTicks = maxIdleTicks;
+    }
+
+    /*Stop SysTick. Note that reading CTRL register clears COUNTFLAG.*/
+    uint32_t ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+
+    /*Cycles remaining until the current tick completes*/
+    uint32_t remainingCycles = SysTick->VAL;
+
+    uint32_t sleepCycles = remainingCycles + (expectedIdleTicks - 1) * tickCycles;
+
+    /*Fire SysTick at the deadline*/
+    SysTick->LOAD = sleepCycles - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL = ctrl | SysTick_CTRL_ENABLE_Msk;
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
 
-    taskNodeType *currentTaskNode = taskPool.blockedQueue.head;
+    if (ctrl & SysTick_CTRL_COUNTFLAG_Msk)
+    {
+        /*Deadline reached. SysTick interrupt is pending and will process the last tick.*/
+        uint32_t overrunCycles = (sleepCycles - 1) - SysTick->VAL;
 
-    while (currentTaskNode != NULL)
+        elapsedTicks = expectedIdleTicks - 1;
+        cyclesToNextTick = (overrunCycles < tickCycles) ? (tickCycles - overrunCycles) : tickCycles;
+    }
+    else
     {
-        /*Save next task node to avoid losing track of linked list after task node
-         is freed while setting corresponding task to READY */
-        taskNodeType *nextTaskNode = currentTaskNode->nextTaskNode;
+        /*Woken up by another interrupt before the deadline*/
+        uint32_t elapsedCycles = (sleepCycles - 1) - SysTick->VAL;
 
-        if (currentTaskNode->pTask->remainingSleepTicks > 0)
+        if (elapsedCycles < remainingCycles)
         {
-            currentTaskNode->pTask->remainingSleepTicks--;
-            if (currentTaskNode->pTask->remainingSleepTicks == 0)
+            elapsedTicks = 0;
+            cyclesToNextTick = remainingCycles - elapsedCycles;
+        }
+        else
+        {
+            elapsedCycles -= remainingCycles;
+            elapsedTicks = 1 + elapsedCycles / tickCycles;
+            cyclesToNextTick = tickCycles - elapsedCycles % tickCycles;
+        }
+    }
+
+    /*Restart SysTick aligned to the tick boundary and restore tick interval for the subsequent ticks*/
+    SysTick->LOAD = cyclesToNextTick - 1;
+    SysTick->VAL = 0;
+    SysTick->CTRL = ctrl | SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = tickCycles - 1;
+
+    return elapsedTicks;
+}
+
+/**
+ * @brief Enter tickless idle mode if no task other than the idle task is ready. Ticks elapsed while sleeping
+ * are processed on wakeup.
+ */
+static void ticklessIdle()
+{
+    __disable_irq();
+
+    /*Enter tickless idle mode only if no other task is ready and no SysTick interrupt is pending*/
+    if (readyQueueEmpty(&taskPool.readyQueue) && !(SCB->ICSR & SCB_ICSR_PENDSTSET_Msk))
+    {
+        uint32_t idleTicks = timeoutQueueNextTimeoutTicks(&taskPool.timeoutQueue);
+        uint32_t timerTicks = timerNextExpiryTicks();
+
+        if (timerTicks < idleTicks)
+        {
+            idleTicks = timerTicks;
+        }
+
+#if (OS_HR_TIMER) && (OS_HR_TIMER_SYSTICK)
+        uint32_t alarmTicks = hrTimerNextAlarmTicks();
+
+        if (alarmTicks < idleTicks)
+        {
+            idleTicks = alarmTicks;
+        }
+#endif
+
+        if (idleTicks >= OS_TICKLESS_MIN_IDLE_TICKS)
+        {
+            uint32_t elapsedTicks = ticklessIdleSleep(idleTicks);
+
+#if (OS_HR_TIMER) && (OS_HR_TIMER_SYSTICK)
+            hrTimerTicklessResync(elapsedTicks);
+#endif
+
+            if (elapsedTicks != 0)
             {
-                if (currentTaskNode->pTask->blockedReason == SLEEP)
-                    taskSetReady(currentTaskNode->pTask, SLEEP_TIME_TIMEOUT);
-                else
-                    taskSetReady(currentTaskNode->pTask, WAIT_TIMEOUT);
+                processTicks(elapsedTicks);
+
+                scheduleNextTask(SCHEDULE_PREEMPT);
             }
         }
-        currentTaskNode = nextTaskNode;
     }
+
+    __enable_irq();
+}
+#endif
+
+/**
+ * @brief Get number of ticks elapsed since the scheduler started. The 64-bit tick count never wraps around and
+ * includes ticks elapsed in tickless idle mode.
+ *
+ * @return Tick count
+ */
+uint64_t schedulerTickCountGet()
+{
+    uint64_t count;
+
+    /*64-bit tick count is read with two loads. Read it again if a tick was processed in between.*/
+    do
+    {
+        count = tickCount;
+    } while (count != tickCount);
+
+    return count;
 }
 
 /**
@@ -130,7 +563,7 @@ void taskYield()
 
     __disable_irq();
 
-    scheduleNextTask();
+    scheduleNextTask(SCHEDULE_YIELD);
 
     __enable_irq();
 
@@ -142,11 +575,29 @@ void taskYield()
 #endif
 }
 
+/**
+ * @brief Switch to the highest priority ready task if it has higher priority than the running task. Unlike taskYield,
+ * the running task keeps the CPU if only tasks of its priority are ready; hence, this is called from interrupt handlers
+ * which wake up tasks outside SysTick handler.
+ */
+void schedulerReschedule()
+{
+    __disable_irq();
+
+    scheduleNextTask(SCHEDULE_PREEMPT);
+
+    __enable_irq();
+}
+
 /**
  * @brief Function to start the RTOS task scheduler.
  */
 void schedulerStart()
 {
+#if (TASK_STACK_PAINTING)
+    mspPaint();
+#endif
+
     /*Start timerTask*/
     timerTaskStart();
 
@@ -162,12 +613,33 @@ void schedulerStart()
     /* Configure SysTick to generate interrupt every OS_INTERVAL_CPU_TICKS */
     SYSTICK_CONFIG();
 
+#if (OS_HR_TIMER)
+    /* Start counting high resolution time*/
+    hrTimerInit();
+#endif
+
+#if (TASK_RUNTIME_STATS)
+#if defined(DWT)
+    /* Enable DWT cycle counter used as the run time counter*/
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    lastAccountCycles = runtimeWindowStartCycles = runtimeCounterRead();
+#endif
+
+#if (OS_TRACE)
+    traceInit();
+#endif
+
     /*Get the highest priority ready task from ready Queue*/
-    currentTask = taskPool.currentTask = taskQueueGet(&taskPool.readyQueue);
+    currentTask = taskPool.currentTask = readyQueueGet(&taskPool.readyQueue);
 
     /*Change status to RUNNING*/
     currentTask->status = TASK_STATUS_RUNNING;
 
+    TRACE_EVENT(TRACE_EVENT_TASK_SWITCH_IN, currentTask, 0);
+
     /* Set PSP to the top of task's stack */
     __set_PSP(currentTask->stackPointer);
 
@@ -188,21 +660,35 @@ void SYSTICK_HANDLER()
 {
     __disable_irq();
 
-    /*Check for timer timeout*/
-    processTimers();
+    TRACE_EVENT(TRACE_EVENT_ISR_ENTER, NULL, SysTick_IRQn);
 
-    /*Check for wait timeout of blocked tasks*/
-    if (!taskQueueEmpty(&taskPool.blockedQueue))
+    bool timeSliceExpired = false;
+
+#if (OS_HR_TIMER) && (OS_HR_TIMER_SYSTICK)
+    /*SysTick period might have been split for an alarm. Process tick only at the end of the tick period.*/
+    if (hrTimerSysTickSegmentEnd())
     {
-        checkTimeout();
+        processTicks(1);
+
+        timeSliceExpired = timeSliceTick();
     }
 
-    /*Perform context switch if required*/
-    scheduleNextTask();
+    hrTimerProcessAlarms();
+#else
+    processTicks(1);
+
+    timeSliceExpired = timeSliceTick();
+#endif
+
+    /*Perform context switch if required. Ready tasks of the same priority are rotated only when the time slice expires.*/
+    scheduleNextTask(timeSliceExpired ? SCHEDULE_TIME_SLICE_EXPIRED : SCHEDULE_PREEMPT);
+
+    TRACE_EVENT(TRACE_EVENT_ISR_EXIT, NULL, SysTick_IRQn);
 
     __enable_irq();
 }
 
+#if !(TASK_RUN_PRIVILEGED)
 /**
  * @brief SVC interrupt service routine(ISR). SVC interrupt is triggered via SYSCALL
  * with a specific SVC number. SVC number is decoded to perform corresponding action.
@@ -244,9 +730,10 @@ void SVC_Handler()
         break;
     case CONTEXT_SWITCH:
         /*Perform context switch if required*/
-        scheduleNextTask();
+        scheduleNextTask(SCHEDULE_YIELD);
         break;
     default:
         break;
     }
 }
+#endif
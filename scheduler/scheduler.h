@@ -67,8 +67,12 @@ extern "C"
 
     void schedulerStart();
 
+    uint64_t schedulerTickCountGet();
+
     void taskYield();
 
+    void schedulerReschedule();
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@
 #include "retCodes.h"
 #include "task/task.h"
 #include "scheduler/scheduler.h"
+#include "trace/trace.h"
 #include "taskQueue/taskQueue.h"
 #include "semaphore.h"
 
@@ -65,13 +66,15 @@ retry:
 
         /*Put current task in semaphore's wait queue*/
 
-        taskQueueAdd(&pSem->waitQueue, currentTask);
+        taskQueueAdd(&pSem->waitQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that the semaphore cannot be given before the task is blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_SEMAPHORE, waitTicks);
 
-        /*Exit from critical section before blocking the task*/
         EXIT_CRITICAL_SECTION();
 
-        /* Block current task and give CPU to other tasks while waiting for semaphore*/
-        taskBlock(currentTask, WAIT_FOR_SEMAPHORE, waitTicks);
+        /*Give CPU to other tasks while waiting for semaphore*/
+        taskYield();
 
         /*Re-enter critical section after being unblocked*/
         ENTER_CRITICAL_SECTION();
@@ -83,7 +86,7 @@ retry:
         else if (currentTask->wakeupReason == WAIT_TIMEOUT)
         {
             /*Wait timed out,remove task from  the waitQueue.*/
-            taskQueueRemove(&pSem->waitQueue, currentTask);
+            taskQueueRemove(&pSem->waitQueue, &currentTask->waitNode);
 
             /*Wait timed out*/
             retCode = RET_TIMEOUT;
@@ -92,11 +95,16 @@ retry:
           In this case, retry taking the semaphore again */
         else
         {
+            /*Remove task from the waitQueue(if still there) before retrying, as its queue node will be re-used.*/
+            taskQueueRemove(&pSem->waitQueue, &currentTask->waitNode);
+
             goto retry;
         }
     }
     EXIT_CRITICAL_SECTION();
 
+    TRACE_EVENT(TRACE_EVENT_SEMAPHORE_TAKE, pSem, retCode);
+
     return retCode;
 }
 
@@ -154,6 +162,9 @@ int semaphoreGive(semaphoreHandleType *pSem)
 
     EXIT_CRITICAL_SECTION();
 
+    /*Recorded before the context switch, as the woken task runs first*/
+    TRACE_EVENT(TRACE_EVENT_SEMAPHORE_GIVE, pSem, retCode);
+
     if (contextSwitchRequired)
     {
         taskYield();
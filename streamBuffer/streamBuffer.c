@@ -0,0 +1,316 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include <assert.h>
+#include "retCodes.h"
+#include "osConfig.h"
+#include "task/task.h"
+#include "scheduler/scheduler.h"
+#include "streamBuffer.h"
+
+/**
+ * @brief Make ready the reader or writer waiting on the stream buffer, unless it was suspended while waiting. This
+ * function must be called from within a critical section.
+ *
+ * @param pWaitQueue Pointer to readerWaitQueue or writerWaitQueue of the stream buffer
+ * @param wakeupReason Wakeup reason
+ * @retval true if the task made ready has equal or higher priority[lower priority value] than that of current task
+ * @retval false otherwise
+ */
+static bool streamWakeup(taskQueueType *pWaitQueue, wakeupReasonType wakeupReason)
+{
+    if (taskQueueEmpty(pWaitQueue))
+    {
+        return false;
+    }
+
+    taskHandleType *pTask = taskQueuePeek(pWaitQueue);
+
+    /*Suspended task checks the stream buffer again once resumed. A task deleted while waiting has been removed from
+    the wait queue by taskDelete.*/
+    if (pTask->status == TASK_STATUS_SUSPENDED)
+    {
+        return false;
+    }
+
+    taskQueueRemove(pWaitQueue, &pTask->waitNode);
+
+    taskSetReady(pTask, wakeupReason);
+
+    return pTask->priority <= taskPool.currentTask->priority;
+}
+
+/**
+ * @brief Block the current task on the stream buffer until it is made ready by the other end or the deadline passes.
+ * This function must be called from within the critical section in which the stream buffer was checked; the task is
+ * blocked before the critical section is exited, so that the other end cannot make it ready before it is blocked.
+ *
+ * @param pWaitQueue Pointer to readerWaitQueue or writerWaitQueue of the stream buffer
+ * @param blockedReason Block reason
+ * @param waitTicks Wait ticks given to streamRead or streamWrite
+ * @param startTick Tick at which streamRead or streamWrite was called
+ * @retval true if the task was made ready by the other end or resumed
+ * @retval false if the deadline has passed
+ */
+static bool streamWait(taskQueueType *pWaitQueue, blockedReasonType blockedReason, uint32_t waitTicks, uint64_t startTick)
+{
+    uint32_t remainingTicks = TASK_MAX_WAIT;
+
+    if (waitTicks != TASK_MAX_WAIT)
+    {
+        uint64_t elapsedTicks = schedulerTickCountGet() - startTick;
+
+        if (elapsedTicks >= waitTicks)
+        {
+            return false;
+        }
+
+        remainingTicks = waitTicks - (uint32_t)elapsedTicks;
+    }
+
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    taskQueueAdd(pWaitQueue, &currentTask->waitNode);
+
+    taskBlockUnlocked(currentTask, blockedReason, remainingTicks);
+
+    EXIT_CRITICAL_SECTION();
+
+    /*Give CPU to other tasks while waiting*/
+    taskYield();
+
+    ENTER_CRITICAL_SECTION();
+
+    /*Task is still in the wait queue if woken up by timeout or resume*/
+    taskQueueRemove(pWaitQueue, &currentTask->waitNode);
+
+    return currentTask->wakeupReason != WAIT_TIMEOUT;
+}
+
+/**
+ * @brief Write bytes to the stream buffer. Bytes are copied outside critical section; the blocked reader is made ready
+ * only once the number of bytes available reaches its wake level. If the stream buffer does not have space for all
+ * bytes, block the task for specified number of wait ticks, writing more bytes as space becomes available. Must be
+ * called by a single writer. If calling this function from an ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ *
+ * @param pStream Pointer to the streamBufferHandle struct
+ * @param pData Pointer to the bytes to write
+ * @param length Number of bytes to write
+ * @param waitTicks Number of ticks to wait for space to write all bytes
+ * @return Number of bytes written
+ */
+uint32_t streamWrite(streamBufferHandleType *pStream, const void *pData, uint32_t length, uint32_t waitTicks)
+{
+    assert(pStream != NULL);
+    assert(pData != NULL || length == 0);
+
+    const uint8_t *pBytes = (const uint8_t *)pData;
+    uint32_t writtenLength = 0;
+    uint64_t startTick = (waitTicks != TASK_NO_WAIT) ? schedulerTickCountGet() : 0;
+
+    while (1)
+    {
+        /*Only the reader changes byteCount meanwhile, and only by freeing space*/
+        uint32_t copyLength = pStream->size - pStream->byteCount;
+
+        if (copyLength > length - writtenLength)
+        {
+            copyLength = length - writtenLength;
+        }
+
+        if (copyLength != 0)
+        {
+            /*Free space is owned by the writer until byteCount is updated; copy in up to two segments*/
+            uint32_t firstLength = pStream->size - pStream->writeIndex;
+
+            if (firstLength > copyLength)
+            {
+                firstLength = copyLength;
+            }
+
+            memcpy(&pStream->buffer[pStream->writeIndex], &pBytes[writtenLength], firstLength);
+            memcpy(pStream->buffer, &pBytes[writtenLength + firstLength], copyLength - firstLength);
+
+            pStream->writeIndex = (pStream->writeIndex + copyLength < pStream->size) ? pStream->writeIndex + copyLength
+                                                                                      : pStream->writeIndex + copyLength - pStream->size;
+            writtenLength += copyLength;
+
+            ENTER_CRITICAL_SECTION();
+
+            pStream->byteCount += copyLength;
+
+            bool contextSwitchRequired = false;
+
+            if (!taskQueueEmpty(&pStream->readerWaitQueue) && pStream->byteCount >= pStream->readerWakeLevel)
+            {
+                contextSwitchRequired = streamWakeup(&pStream->readerWaitQueue, STREAM_DATA_AVAILABLE);
+            }
+
+            EXIT_CRITICAL_SECTION();
+
+            if (contextSwitchRequired)
+            {
+                taskYield();
+            }
+        }
+
+        if (writtenLength == length || waitTicks == TASK_NO_WAIT)
+        {
+            break;
+        }
+
+        ENTER_CRITICAL_SECTION();
+
+        /*Reader might have freed space since it was checked*/
+        bool waited = true;
+
+        if (pStream->byteCount == pStream->size)
+        {
+            uint32_t remainingLength = length - writtenLength;
+
+            /*Wake up once the rest can be written in one go, to avoid a wakeup per byte freed*/
+            pStream->writerWakeSpace = (remainingLength < pStream->size) ? remainingLength : pStream->size;
+
+            waited = streamWait(&pStream->writerWaitQueue, WAIT_FOR_STREAM_SPACE, waitTicks, startTick);
+        }
+
+        EXIT_CRITICAL_SECTION();
+
+        if (!waited)
+        {
+            break;
+        }
+    }
+
+    return writtenLength;
+}
+
+/**
+ * @brief Read bytes from the stream buffer. If fewer bytes than the trigger level(or maxLength, if smaller) are
+ * available, block the task until they are, or until specified number of wait ticks pass; the bytes available then are
+ * read. Bytes are copied outside critical section. Must be called by a single reader. If calling this function from an
+ * ISR, the parameter waitTicks should be set to TASK_NO_WAIT.
+ *
+ * @param pStream Pointer to the streamBufferHandle struct
+ * @param pData Pointer to the buffer to copy the bytes to
+ * @param maxLength Maximum number of bytes to read
+ * @param waitTicks Number of ticks to wait for the trigger level to be reached
+ * @return Number of bytes read. 0 if no bytes were available before wait timed out.
+ */
+uint32_t streamRead(streamBufferHandleType *pStream, void *pData, uint32_t maxLength, uint32_t waitTicks)
+{
+    assert(pStream != NULL);
+    assert(pData != NULL || maxLength == 0);
+
+    uint8_t *pBytes = (uint8_t *)pData;
+    uint32_t wakeLevel = (pStream->triggerLevel < maxLength) ? pStream->triggerLevel : maxLength;
+    uint64_t startTick = (waitTicks != TASK_NO_WAIT) ? schedulerTickCountGet() : 0;
+
+    if (wakeLevel == 0)
+    {
+        wakeLevel = 1;
+    }
+
+    ENTER_CRITICAL_SECTION();
+
+    while (pStream->byteCount < wakeLevel && waitTicks != TASK_NO_WAIT)
+    {
+        pStream->readerWakeLevel = wakeLevel;
+
+        if (!streamWait(&pStream->readerWaitQueue, WAIT_FOR_STREAM_DATA, waitTicks, startTick))
+        {
+            break;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    /*Only the writer changes byteCount meanwhile, and only by adding bytes*/
+    uint32_t copyLength = pStream->byteCount;
+
+    if (copyLength > maxLength)
+    {
+        copyLength = maxLength;
+    }
+
+    if (copyLength == 0)
+    {
+        return 0;
+    }
+
+    /*Available bytes are owned by the reader until byteCount is updated; copy in up to two segments*/
+    uint32_t firstLength = pStream->size - pStream->readIndex;
+
+    if (firstLength > copyLength)
+    {
+        firstLength = copyLength;
+    }
+
+    memcpy(pBytes, &pStream->buffer[pStream->readIndex], firstLength);
+    memcpy(&pBytes[firstLength], pStream->buffer, copyLength - firstLength);
+
+    pStream->readIndex = (pStream->readIndex + copyLength < pStream->size) ? pStream->readIndex + copyLength
+                                                                           : pStream->readIndex + copyLength - pStream->size;
+
+    ENTER_CRITICAL_SECTION();
+
+    pStream->byteCount -= copyLength;
+
+    bool contextSwitchRequired = false;
+
+    if (!taskQueueEmpty(&pStream->writerWaitQueue) && pStream->size - pStream->byteCount >= pStream->writerWakeSpace)
+    {
+        contextSwitchRequired = streamWakeup(&pStream->writerWaitQueue, STREAM_SPACE_AVAILABLE);
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return copyLength;
+}
+
+/**
+ * @brief Set the trigger level of the stream buffer, i.e. the number of bytes that must be available to wake up a
+ * reader blocked in streamRead. A lower level reduces latency, a higher level reduces wakeups.
+ *
+ * @param pStream Pointer to the streamBufferHandle struct
+ * @param triggerLevel Trigger level in bytes[1 to size of the stream buffer]
+ */
+void streamTriggerLevelSet(streamBufferHandleType *pStream, uint32_t triggerLevel)
+{
+    assert(pStream != NULL);
+    assert(triggerLevel >= 1 && triggerLevel <= pStream->size);
+
+    ENTER_CRITICAL_SECTION();
+
+    pStream->triggerLevel = triggerLevel;
+
+    EXIT_CRITICAL_SECTION();
+}
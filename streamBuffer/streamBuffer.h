@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_STREAM_BUFFER_H
+#define __SANO_RTOS_STREAM_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "osConfig.h"
+#include "task/task.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Statically define and initialize a stream buffer, a byte pipe from a single writer to a single reader. A reader
+ * blocked in streamRead is woken up only once trigger_level bytes are available or its wait times out.
+ * @param name Name of the stream buffer.
+ * @param buffer_size Size of the stream buffer in bytes.
+ * @param trigger_level Number of bytes that must be available to wake up a blocked reader[1 to buffer_size].
+ */
+#define STREAM_BUFFER_DEFINE(name, buffer_size, trigger_level) \
+    uint8_t name##Buffer[buffer_size];                         \
+    streamBufferHandleType name = {                            \
+        .buffer = name##Buffer,                                \
+        .size = buffer_size,                                   \
+        .triggerLevel = trigger_level,                         \
+        .byteCount = 0,                                        \
+        .readIndex = 0,                                        \
+        .writeIndex = 0,                                       \
+        .readerWaitQueue = {0},                                \
+        .writerWaitQueue = {0},                                \
+        .readerWakeLevel = 0,                                  \
+        .writerWakeSpace = 0}
+
+    typedef struct
+    {
+        uint8_t *buffer;
+        uint32_t size;
+        uint32_t triggerLevel;
+        volatile uint32_t byteCount; // Number of bytes in the stream buffer
+        uint32_t readIndex;          // Updated by the reader only
+        uint32_t writeIndex;         // Updated by the writer only
+        taskQueueType readerWaitQueue; // Holds the reader task blocked waiting for bytes
+        taskQueueType writerWaitQueue; // Holds the writer task blocked waiting for space
+        uint32_t readerWakeLevel; // Number of bytes that must be available to wake up the waiting reader
+        uint32_t writerWakeSpace; // Number of free bytes required to wake up the waiting writer
+    } streamBufferHandleType;
+
+    uint32_t streamWrite(streamBufferHandleType *pStream, const void *pData, uint32_t length, uint32_t waitTicks);
+
+    uint32_t streamRead(streamBufferHandleType *pStream, void *pData, uint32_t maxLength, uint32_t waitTicks);
+
+    void streamTriggerLevelSet(streamBufferHandleType *pStream, uint32_t triggerLevel);
+
+    /**
+     * @brief Get number of bytes available to read from the stream buffer
+     *
+     * @param pStream Pointer to the streamBufferHandle struct
+     * @return Number of bytes
+     */
+    static inline uint32_t streamBytesAvailable(streamBufferHandleType *pStream)
+    {
+        return pStream->byteCount;
+    }
+
+    /**
+     * @brief Get number of bytes that can be written to the stream buffer without blocking
+     *
+     * @param pStream Pointer to the streamBufferHandle struct
+     * @return Number of bytes
+     */
+    static inline uint32_t streamSpaceAvailable(streamBufferHandleType *pStream)
+    {
+        return pStream->size - pStream->byteCount;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -27,23 +27,131 @@
 #include "osConfig.h"
 #include "scheduler/scheduler.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
+#include "timeoutQueue/timeoutQueue.h"
+#include "hrTimer/hrTimer.h"
+#include "trace/trace.h"
 #include "task.h"
 
 taskPoolType taskPool = {0};
 taskHandleType *currentTask;
 taskHandleType *nextTask;
 
+#if (TASK_POOL_SIZE > 0)
+#if defined(PLATFORM_POSIX)
+#define TASK_POOL_STACK_WORDS (POSIX_TASK_STACK_SIZE(TASK_POOL_STACK_SIZE) / sizeof(uint32_t))
+#else
+#define TASK_POOL_STACK_WORDS (TASK_POOL_STACK_SIZE / sizeof(uint32_t))
+#endif
+
+/*Pools of task control blocks and stacks of the tasks created with taskCreate. Slot n of each pool belongs to the same task.*/
+static taskHandleType taskSlots[TASK_POOL_SIZE];
+static uint32_t taskSlotStacks[TASK_POOL_SIZE][TASK_POOL_STACK_WORDS];
+#if defined(PLATFORM_POSIX)
+static posixTaskContextType taskSlotContexts[TASK_POOL_SIZE];
+#endif
+
+static taskNodeType *freeTaskSlotList = NULL; // Returned slots, linked through the stateNode of their taskHandle struct
+static uint32_t unusedTaskSlotIndex = 0;      // Slots from this index onwards have never been used
+
+/**
+ * @brief Take a slot from the task pools. This function must be called from within a critical section.
+ *
+ * @retval Pointer to taskHandle struct of the slot
+ * @retval NULL if all slots are in use
+ */
+static taskHandleType *taskSlotAlloc()
+{
+    if (freeTaskSlotList != NULL)
+    {
+        taskNodeType *pSlotNode = freeTaskSlotList;
+
+        freeTaskSlotList = pSlotNode->nextTaskNode;
+
+        return pSlotNode->pTask;
+    }
+
+    if (unusedTaskSlotIndex < TASK_POOL_SIZE)
+    {
+        return &taskSlots[unusedTaskSlotIndex++];
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Return slot of a deleted task to the task pools. Nothing is done for a task not created with taskCreate.
+ * This function must be called from within a critical section.
+ *
+ * @param pTask Pointer to taskHandle struct of the deleted task
+ */
+static void taskSlotFree(taskHandleType *pTask)
+{
+    if (pTask >= taskSlots && pTask < taskSlots + TASK_POOL_SIZE)
+    {
+        pTask->stateNode.nextTaskNode = freeTaskSlotList;
+        freeTaskSlotList = &pTask->stateNode;
+    }
+}
+#endif
+
 /**
- * @brief Function to execute when task returns
+ * @brief Function to execute when task returns. The task is deleted; hence, tasks waiting in taskJoin for it are
+ * made ready and its slot is returned to the task pools if it was created with taskCreate.
  *
  */
 void taskExitFunction()
 {
+    taskDelete(taskPool.currentTask);
 
+    /*Not reached, as the deleted task is never scheduled again*/
     while (1)
         ;
 }
 
+#if (TASK_STACK_PAINTING)
+/**
+ * @brief Get high-water mark of the task stack, i.e. the maximum number of bytes of the stack used so far. Stack words
+ * still holding TASK_STACK_PAINT_PATTERN are counted as never used.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @return Maximum stack usage in bytes
+ */
+uint32_t taskStackHighWaterMarkGet(taskHandleType *pTask)
+{
+    assert(pTask != NULL);
+
+    uint32_t stackWords = pTask->stackSize / sizeof(uint32_t);
+    uint32_t index = TASK_STACK_CANARY_WORDS;
+
+    while (index < stackWords && pTask->stackBase[index] == TASK_STACK_PAINT_PATTERN)
+    {
+        index++;
+    }
+
+    return (stackWords - index) * sizeof(uint32_t);
+}
+#endif
+
+#if (TASK_STACK_OVERFLOW_CHECK)
+/**
+ * @brief Called from PendSV handler, with interrupts disabled, when the stack of the task being switched out has
+ * overflowed. Memory below the stack has been corrupted; hence, execution cannot continue safely. It is defined weak,
+ * so that the application can override it, e.g. to log the task and reset.
+ *
+ * @param pTask Pointer to taskHandle struct of the task whose stack has overflowed
+ */
+__WEAK void taskStackOverflowHandler(taskHandleType *pTask)
+{
+    (void)pTask;
+
+    __BKPT(0);
+
+    while (1)
+        ;
+}
+#endif
+
 /**
  * @brief Change task's status to ready
  * @param pTask Pointer to the taskHandle struct.
@@ -54,20 +162,54 @@ void taskSetReady(taskHandleType *pTask, wakeupReasonType wakeupReason)
 
     if (pTask->status == TASK_STATUS_BLOCKED)
     {
-        /* Remove  task from the queue of blocked tasks*/
-        taskQueueRemove(&taskPool.blockedQueue, pTask);
+        /* Remove  task from the queue of tasks waiting with timeout*/
+        timeoutQueueRemove(&taskPool.timeoutQueue, &pTask->stateNode);
     }
-    pTask->status = TASK_STATUS_READY;
+
     pTask->blockedReason = BLOCK_REASON_NONE;
     pTask->wakeupReason = wakeupReason;
-    pTask->remainingSleepTicks = 0;
 
-    /* Add task to queue of ready tasks*/
-    taskQueueAdd(&taskPool.readyQueue, pTask);
+    TRACE_EVENT(TRACE_EVENT_TASK_READY, pTask, wakeupReason);
+
+    /* Add task to queue of ready tasks if it is not already there. Task's queue node is embedded in
+    the taskHandle struct; hence, the task must not be added twice. The running task, e.g. made ready by a wakeup
+    arriving after its wait timed out, is not blocked; only the wakeup reason is recorded for it.*/
+    if (pTask->status != TASK_STATUS_READY && pTask->status != TASK_STATUS_RUNNING)
+    {
+        pTask->status = TASK_STATUS_READY;
+        readyQueueAdd(&taskPool.readyQueue, &pTask->stateNode);
+    }
 }
 
 /**
- * @brief Block task with the specified blocking reason and number to ticks to block the task for.
+ * @brief Block task without entering critical section. This function must be called from within a critical section,
+ * in the same critical section in which the task is added to a wait queue and its wait condition is checked, so that
+ * no wakeup can happen before the task is blocked. The caller must yield after exiting the critical section.
+ *
+ * @param pTask Pointer to taskHandle struct.
+ * @param blockReason Block reason
+ * @param ticks Number to ticks to block the task for.
+ */
+void taskBlockUnlocked(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks)
+{
+    pTask->status = TASK_STATUS_BLOCKED;
+    pTask->blockedReason = blockedReason;
+    pTask->wakeupReason = WAKEUP_REASON_NONE;
+
+    TRACE_EVENT(TRACE_EVENT_TASK_BLOCK, pTask, blockedReason);
+
+    /* Add task to the queue of tasks waiting with timeout. Tasks blocked without timeout(ticks = 0 or TASK_MAX_WAIT)
+    are not kept in any queue; they are unblocked only by taskSetReady*/
+    if (ticks != 0 && ticks != TASK_MAX_WAIT)
+    {
+        timeoutQueueAdd(&taskPool.timeoutQueue, &pTask->stateNode, ticks);
+    }
+}
+
+/**
+ * @brief Block task with the specified blocking reason and number to ticks to block the task for. A task waiting in the
+ * wait queue of an object must be blocked with taskBlockUnlocked instead, in the critical section adding it to the
+ * wait queue.
  *
  * @param pTask Pointer to taskHandle struct.
  * @param blockReason Block reason
@@ -79,20 +221,169 @@ void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t
 
     ENTER_CRITICAL_SECTION();
 
-    pTask->remainingSleepTicks = ticks;
-    pTask->status = TASK_STATUS_BLOCKED;
-    pTask->blockedReason = blockedReason;
-    pTask->wakeupReason = WAKEUP_REASON_NONE;
+    taskBlockUnlocked(pTask, blockedReason, ticks);
+
+    EXIT_CRITICAL_SECTION();
+
+    // Give CPU to other tasks
+    taskYield();
+}
+
+#if (OS_HR_TIMER)
+/**
+ * @brief Alarm callback to wake up a task sleeping in taskSleepUS
+ *
+ * @param pAlarm Pointer to the hrAlarm struct
+ */
+static void taskSleepAlarmCallback(hrAlarmType *pAlarm)
+{
+    taskHandleType *pTask = (taskHandleType *)pAlarm->context;
+
+    if (pTask->status == TASK_STATUS_BLOCKED && pTask->blockedReason == SLEEP)
+    {
+        taskSetReady(pTask, SLEEP_TIME_TIMEOUT);
+    }
+}
+#endif
+
+/**
+ * @brief Block task for specified number of microseconds. With OS_HR_TIMER, the task is woken up by a high resolution
+ * alarm; hence, sleep time is not limited to whole ticks. Otherwise, sleep time is rounded up to a whole number of ticks.
+ *
+ * @param sleepTimeUS
+ */
+void taskSleepUS(uint32_t sleepTimeUS)
+{
+#if (OS_HR_TIMER)
+    taskHandleType *pTask = taskPool.currentTask;
 
-    // Add task to queue of blocked tasks. We dont need to sort tasks in blockedQueue
-    taskQueueAddToFront(&taskPool.blockedQueue, pTask);
+    uint64_t sleepCycles = (uint64_t)sleepTimeUS * SystemCoreClock / 1000000;
+
+    ENTER_CRITICAL_SECTION();
+
+    /*Alarm cannot expire before the task is blocked, as interrupts are disabled*/
+    hrAlarmStart(&pTask->sleepAlarm, hrTimerCyclesGet() + sleepCycles, taskSleepAlarmCallback, pTask);
+
+    taskBlockUnlocked(pTask, SLEEP, TASK_MAX_WAIT);
 
     EXIT_CRITICAL_SECTION();
 
     // Give CPU to other tasks
     taskYield();
+
+    /*Task might have been woken up before the alarm expired, e.g. when suspended and resumed*/
+    hrAlarmStop(&pTask->sleepAlarm);
+#else
+    taskSleep(sleepTimeUS / OS_TICK_INTERVAL_US + ((sleepTimeUS % OS_TICK_INTERVAL_US) != 0));
+#endif
+}
+
+/**
+ * @brief Block the current task until the tick (*pLastWakeTick + periodTicks) and update *pLastWakeTick to this tick.
+ * Unlike taskSleep, the wake tick does not depend on when this function is called; hence, a task calling this function
+ * in a loop is released exactly every periodTicks without accumulating drift. *pLastWakeTick should be initialized
+ * with schedulerTickCountGet() before the first call. If the wake tick has already passed, the task is not blocked,
+ * but the wake tick still advances by one period to keep the task's phase.
+ *
+ * @param pLastWakeTick Pointer to the tick at which the task was last released
+ * @param periodTicks Release period in ticks
+ * @retval true if the task was blocked until the wake tick
+ * @retval false if the wake tick had already passed
+ */
+bool taskSleepUntil(uint64_t *pLastWakeTick, uint32_t periodTicks)
+{
+    assert(pLastWakeTick != NULL);
+
+    taskHandleType *pTask = taskPool.currentTask;
+    bool blocked = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    uint64_t wakeTick = *pLastWakeTick + periodTicks;
+    uint64_t tickCount = schedulerTickCountGet();
+
+    *pLastWakeTick = wakeTick;
+
+    /*Tick count cannot change inside critical section; hence, the task wakes up exactly at wakeTick*/
+    if (wakeTick > tickCount)
+    {
+        taskBlockUnlocked(pTask, SLEEP, (uint32_t)(wakeTick - tickCount));
+
+        blocked = true;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (blocked)
+    {
+        // Give CPU to other tasks
+        taskYield();
+    }
+
+#if (TASK_RELEASE_STATS)
+    /*Lateness of the release is the number of ticks between the wake tick and the tick at which the task runs again*/
+    uint64_t releaseTick = schedulerTickCountGet();
+    uint32_t latenessTicks = (releaseTick > wakeTick) ? (uint32_t)(releaseTick - wakeTick) : 0;
+
+    ENTER_CRITICAL_SECTION();
+
+    pTask->releaseStats.releaseCount++;
+
+    if (wakeTick <= tickCount)
+    {
+        pTask->releaseStats.missedCount++;
+    }
+
+    pTask->releaseStats.lastLatenessTicks = latenessTicks;
+    pTask->releaseStats.totalLatenessTicks += latenessTicks;
+
+    if (latenessTicks > pTask->releaseStats.maxLatenessTicks)
+    {
+        pTask->releaseStats.maxLatenessTicks = latenessTicks;
+    }
+
+    EXIT_CRITICAL_SECTION();
+#endif
+
+    return blocked;
 }
 
+#if (TASK_RELEASE_STATS)
+/**
+ * @brief Get release statistics of a task released periodically with taskSleepUntil.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param pReleaseStats Pointer to the taskReleaseStats struct to copy the statistics to
+ */
+void taskReleaseStatsGet(taskHandleType *pTask, taskReleaseStatsType *pReleaseStats)
+{
+    assert(pTask != NULL);
+    assert(pReleaseStats != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    *pReleaseStats = pTask->releaseStats;
+
+    EXIT_CRITICAL_SECTION();
+}
+
+/**
+ * @brief Reset release statistics of a task
+ *
+ * @param pTask Pointer to taskHandle struct
+ */
+void taskReleaseStatsReset(taskHandleType *pTask)
+{
+    assert(pTask != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    pTask->releaseStats = (taskReleaseStatsType){0};
+
+    EXIT_CRITICAL_SECTION();
+}
+#endif
+
 /**
  * @brief Suspend task
  *
@@ -107,19 +398,20 @@ void taskSuspend(taskHandleType *pTask)
     /* If task status is ready, remove it from the readyQueue*/
     if (pTask->status == TASK_STATUS_READY)
     {
-        taskQueueRemove(&taskPool.readyQueue, pTask);
+        readyQueueRemove(&taskPool.readyQueue, &pTask->stateNode);
     }
-    /*If task status is blocked, remove it from the blockedQueue*/
+    /*If task status is blocked, remove it from the timeoutQueue*/
     else if (pTask->status == TASK_STATUS_BLOCKED)
     {
-        taskQueueRemove(&taskPool.blockedQueue, pTask);
+        timeoutQueueRemove(&taskPool.timeoutQueue, &pTask->stateNode);
     }
 
-    pTask->remainingSleepTicks = 0;
     pTask->status = TASK_STATUS_SUSPENDED;
     pTask->blockedReason = BLOCK_REASON_NONE;
     pTask->wakeupReason = WAKEUP_REASON_NONE;
 
+    TRACE_EVENT(TRACE_EVENT_TASK_SUSPEND, pTask, 0);
+
     EXIT_CRITICAL_SECTION();
 
     /*If self suspended, give CPU to other tasks*/
@@ -129,6 +421,48 @@ void taskSuspend(taskHandleType *pTask)
     }
 }
 
+/**
+ * @brief Change priority of the task. If the task is ready, it is moved to the ready list of its new priority.
+ * This function must be called from within a critical section.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param priority New priority of the task
+ */
+void taskPrioritySet(taskHandleType *pTask, uint8_t priority)
+{
+    assert(pTask != NULL);
+    assert(priority < TASK_PRIORITY_LEVELS);
+
+    if (pTask->status == TASK_STATUS_READY)
+    {
+        readyQueueRemove(&taskPool.readyQueue, &pTask->stateNode);
+        pTask->priority = priority;
+        readyQueueAdd(&taskPool.readyQueue, &pTask->stateNode);
+    }
+    else
+    {
+        pTask->priority = priority;
+    }
+}
+
+/**
+ * @brief Set time slice of the task for round-robin scheduling among tasks having the same priority.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @param timeSliceTicks Time slice in ticks. 0 disables time slicing for the task.
+ */
+void taskTimeSliceSet(taskHandleType *pTask, uint16_t timeSliceTicks)
+{
+    assert(pTask != NULL);
+
+    ENTER_CRITICAL_SECTION();
+
+    pTask->timeSliceTicks = timeSliceTicks;
+    pTask->remainingSliceTicks = timeSliceTicks;
+
+    EXIT_CRITICAL_SECTION();
+}
+
 /**
  * @brief Resume task from suspended state
  *
@@ -148,3 +482,431 @@ int taskResume(taskHandleType *pTask)
 
     return RET_NOTSUSPENDED;
 }
+
+/**
+ * @brief Delete a task. The task is removed from the queue of ready tasks, the queue of tasks waiting with timeout and
+ * the wait queue of the object it is waiting for, and tasks waiting in taskJoin for it are made ready. Slot of a task
+ * created with taskCreate is returned to the task pools; hence, its taskHandle struct must not be used afterwards.
+ * A task deleting itself does not return. The deleted task must not own a mutex. This function must not be called
+ * from an ISR.
+ *
+ * @param pTask Pointer to taskHandle struct
+ * @retval RET_SUCCESS if task deleted successfully
+ * @retval RET_NOTACTIVE if task has already been deleted
+ */
+int taskDelete(taskHandleType *pTask)
+{
+    assert(pTask != NULL);
+
+    bool contextSwitchRequired = (pTask == taskPool.currentTask);
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pTask->status == TASK_STATUS_DELETED)
+    {
+        EXIT_CRITICAL_SECTION();
+
+        return RET_NOTACTIVE;
+    }
+
+    /* If task status is ready, remove it from the readyQueue*/
+    if (pTask->status == TASK_STATUS_READY)
+    {
+        readyQueueRemove(&taskPool.readyQueue, &pTask->stateNode);
+    }
+    /*If task status is blocked, remove it from the timeoutQueue*/
+    else if (pTask->status == TASK_STATUS_BLOCKED)
+    {
+        timeoutQueueRemove(&taskPool.timeoutQueue, &pTask->stateNode);
+    }
+
+    /*Task might be waiting for a mutex, semaphore, msgQueue, condVar or another task, or might have been suspended
+    while waiting; remove it from the wait queue, as its queue node must not be left linked to the queue.*/
+    if (pTask->waitNode.pTaskQueue != NULL)
+    {
+        taskQueueRemove(pTask->waitNode.pTaskQueue, &pTask->waitNode);
+    }
+
+#if (OS_HR_TIMER)
+    /*Task might be sleeping in taskSleepUS, or might have been suspended while sleeping; its alarm must not be left
+    linked to the alarm list.*/
+    hrAlarmStop(&pTask->sleepAlarm);
+#endif
+
+    pTask->status = TASK_STATUS_DELETED;
+    pTask->blockedReason = BLOCK_REASON_NONE;
+    pTask->wakeupReason = WAKEUP_REASON_NONE;
+
+    /*Make ready all tasks waiting for the task to exit*/
+    taskHandleType *pJoinTask;
+
+    while ((pJoinTask = taskQueueGet(&pTask->joinQueue)) != NULL)
+    {
+        /*If task was suspended while waiting, skip the task*/
+        if (pJoinTask->status == TASK_STATUS_SUSPENDED)
+        {
+            continue;
+        }
+
+        taskSetReady(pJoinTask, TASK_EXITED);
+
+        /*Perform context switch if unblocked task has equal or higher priority[lower priority value] than that of current task */
+        if (pJoinTask->priority <= taskPool.currentTask->priority)
+        {
+            contextSwitchRequired = true;
+        }
+    }
+
+#if (TASK_POOL_SIZE > 0)
+    /*Slot cannot be reused before a task deleting itself is switched out, as taskCreate is called from tasks only*/
+    taskSlotFree(pTask);
+#endif
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+
+/**
+ * @brief Wait for a task to exit, i.e. to return from its entry function or to be deleted with taskDelete. Slot of a
+ * task created with taskCreate is reused once the task exits; hence, the wait must start before the task exits, unless
+ * no task is created in between.
+ *
+ * @param pTask Pointer to taskHandle struct of the task to wait for
+ * @param waitTicks Number of ticks to wait for the task to exit
+ * @retval RET_SUCCESS if the task has exited
+ * @retval RET_BUSY if the task has not exited and waitTicks is TASK_NO_WAIT
+ * @retval RET_TIMEOUT if timeout occured while waiting for the task to exit
+ */
+int taskJoin(taskHandleType *pTask, uint32_t waitTicks)
+{
+    assert(pTask != NULL);
+    assert(pTask != taskPool.currentTask);
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (pTask->status == TASK_STATUS_DELETED)
+    {
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_BUSY;
+    }
+    else
+    {
+        taskHandleType *currentTask = taskPool.currentTask;
+
+        /*Put current task in the join queue of the task*/
+        taskQueueAdd(&pTask->joinQueue, &currentTask->waitNode);
+
+        /*Block current task in the same critical section, so that the task cannot exit before the current task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_TASK_EXIT, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        /* Give CPU to other tasks while waiting for the task to exit*/
+        taskYield();
+
+        /*Re-enter critical section after being unblocked*/
+        ENTER_CRITICAL_SECTION();
+
+        if (currentTask->wakeupReason == TASK_EXITED)
+        {
+            retCode = RET_SUCCESS;
+        }
+        else if (currentTask->wakeupReason == WAIT_TIMEOUT)
+        {
+            /*Wait timed out,remove task from  the joinQueue.*/
+            taskQueueRemove(&pTask->joinQueue, &currentTask->waitNode);
+
+            retCode = RET_TIMEOUT;
+        }
+        /*Task might have been suspended while waiting and later resumed. In this case, check the task again */
+        else
+        {
+            /*Remove task from the joinQueue(if still there) before retrying, as its queue node will be re-used.*/
+            taskQueueRemove(&pTask->joinQueue, &currentTask->waitNode);
+
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Notify a task, updating its notification value as specified by the action. The notification value and state
+ * are kept in the task control block; hence, no wait queue or separate object is needed to signal a known task. If the
+ * task is waiting in taskNotifyWait, it is made ready. Can be called from an ISR.
+ *
+ * @param pTask Pointer to taskHandle struct of the task to notify
+ * @param value Value used to update the notification value
+ * @param action Action performed on the notification value
+ * @retval RET_SUCCESS if the task is notified
+ * @retval RET_BUSY if action is TASK_NOTIFY_SET_VALUE_NO_OVERWRITE and a notification is pending
+ * @retval RET_NOTACTIVE if the task has been deleted
+ */
+int taskNotify(taskHandleType *pTask, uint32_t value, taskNotifyActionType action)
+{
+    assert(pTask != NULL);
+
+    int retCode = RET_SUCCESS;
+
+    bool contextSwitchRequired = false;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pTask->status == TASK_STATUS_DELETED)
+    {
+        retCode = RET_NOTACTIVE;
+    }
+    else if (action == TASK_NOTIFY_SET_VALUE_NO_OVERWRITE && pTask->notifyState == TASK_NOTIFY_STATE_PENDING)
+    {
+        retCode = RET_BUSY;
+    }
+    else
+    {
+        switch (action)
+        {
+        case TASK_NOTIFY_SET_BITS:
+            pTask->notifyValue |= value;
+            break;
+
+        case TASK_NOTIFY_INCREMENT:
+            pTask->notifyValue++;
+            break;
+
+        case TASK_NOTIFY_OVERWRITE:
+        case TASK_NOTIFY_SET_VALUE_NO_OVERWRITE:
+            pTask->notifyValue = value;
+            break;
+
+        default:
+            break;
+        }
+
+        /*Make the task ready if it is waiting for a notification. A task suspended while waiting receives the
+        notification when resumed.*/
+        if (pTask->notifyState == TASK_NOTIFY_STATE_WAITING && pTask->status != TASK_STATUS_SUSPENDED)
+        {
+            taskSetReady(pTask, NOTIFICATION_RECEIVED);
+
+            /*Perform context switch if unblocked task has equal or
+             *higher priority[lower priority value] than that of current task */
+            if (pTask != taskPool.currentTask && pTask->priority <= taskPool.currentTask->priority)
+            {
+                contextSwitchRequired = true;
+            }
+        }
+
+        pTask->notifyState = TASK_NOTIFY_STATE_PENDING;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return retCode;
+}
+
+/**
+ * @brief Wait for a notification to the current task. The notification value is received and the bits of clearMask
+ * are cleared in it. This function must not be called from an ISR.
+ *
+ * @param clearMask Bits of the notification value to clear on receiving a notification. 0xffffffff resets the value.
+ * @param pValue Pointer to the variable to be assigned the notification value, before clearing. Can be NULL.
+ * @param waitTicks Number of ticks to wait if no notification is pending
+ * @retval RET_SUCCESS if a notification is received
+ * @retval RET_EMPTY if no notification is pending and waitTicks is TASK_NO_WAIT
+ * @retval RET_TIMEOUT if timeout occured while waiting for a notification
+ */
+int taskNotifyWait(uint32_t clearMask, uint32_t *pValue, uint32_t waitTicks)
+{
+    taskHandleType *currentTask = taskPool.currentTask;
+
+    uint32_t value = 0;
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+retry:
+    if (currentTask->notifyState == TASK_NOTIFY_STATE_PENDING)
+    {
+        value = currentTask->notifyValue;
+
+        currentTask->notifyValue &= ~clearMask;
+        currentTask->notifyState = TASK_NOTIFY_STATE_NONE;
+
+        retCode = RET_SUCCESS;
+    }
+    else if (waitTicks == TASK_NO_WAIT)
+    {
+        retCode = RET_EMPTY;
+    }
+    else
+    {
+        currentTask->notifyState = TASK_NOTIFY_STATE_WAITING;
+
+        /*Block current task in the same critical section, so that a notification cannot arrive before the task is
+        blocked*/
+        taskBlockUnlocked(currentTask, WAIT_FOR_NOTIFICATION, waitTicks);
+
+        EXIT_CRITICAL_SECTION();
+
+        /* Give CPU to other tasks while waiting for a notification*/
+        taskYield();
+
+        /*Re-enter critical section after being unblocked*/
+        ENTER_CRITICAL_SECTION();
+
+        /*A notification might have arrived after the wait timed out. Task might also have been suspended while
+          waiting and later resumed. In both cases, check the notification state again. */
+        if (currentTask->wakeupReason == WAIT_TIMEOUT && currentTask->notifyState != TASK_NOTIFY_STATE_PENDING)
+        {
+            currentTask->notifyState = TASK_NOTIFY_STATE_NONE;
+
+            retCode = RET_TIMEOUT;
+        }
+        else
+        {
+            goto retry;
+        }
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    if (pValue != NULL)
+    {
+        *pValue = value;
+    }
+
+    return retCode;
+}
+
+#if (TASK_POOL_SIZE > 0)
+/**
+ * @brief Create a task at run time. Task control block and a stack of TASK_POOL_STACK_SIZE bytes are taken from the
+ * task pools and the stack is initialized as by TASK_DEFINE. The task is made ready and preempts the calling task if
+ * it has higher priority; if called from main, it starts running once the scheduler is started. Both are returned to
+ * the pools when the task exits or is deleted. This function must not be called from an ISR.
+ *
+ * @param taskEntry Task entry function
+ * @param params Entry function parameter
+ * @param priority Task priority
+ * @param ppTask Pointer to store pointer to taskHandle struct of the created task. Can be NULL.
+ * @retval RET_SUCCESS if task created successfully
+ * @retval RET_NOMEM if all slots of the task pools are in use
+ */
+int taskCreate(taskFunctionType taskEntry, void *params, uint8_t priority, taskHandleType **ppTask)
+{
+    assert(taskEntry != NULL);
+    assert(priority < TASK_PRIORITY_LEVELS);
+
+    ENTER_CRITICAL_SECTION();
+
+    taskHandleType *pTask = taskSlotAlloc();
+
+    EXIT_CRITICAL_SECTION();
+
+    if (pTask == NULL)
+    {
+        return RET_NOMEM;
+    }
+
+    uint32_t slotIndex = pTask - taskSlots;
+    uint32_t *stack = taskSlotStacks[slotIndex];
+
+#if (TASK_STACK_OVERFLOW_CHECK)
+    stack[0] = TASK_STACK_CANARY;
+#endif
+
+#if defined(PLATFORM_POSIX)
+#if (TASK_STACK_PAINTING)
+    for (uint32_t index = TASK_STACK_CANARY_WORDS; index < TASK_POOL_STACK_WORDS; index++)
+    {
+        stack[index] = TASK_STACK_PAINT_PATTERN;
+    }
+#endif
+
+    taskSlotContexts[slotIndex] = (posixTaskContextType){.stack = stack, .stackBytes = sizeof(taskSlotStacks[0]), .started = false};
+
+    uintptr_t stackPointer = (uintptr_t)&taskSlotContexts[slotIndex];
+#else
+    uint32_t *stackTop = stack + TASK_POOL_STACK_WORDS;
+
+#if (TASK_STACK_PAINTING)
+    for (uint32_t index = TASK_STACK_CANARY_WORDS; index < TASK_POOL_STACK_WORDS - 17; index++)
+    {
+        stack[index] = TASK_STACK_PAINT_PATTERN;
+    }
+#endif
+
+    /*Default stack contents, as described in task.h*/
+    memset(stackTop - 17, 0, 17 * sizeof(uint32_t));
+
+    stackTop[-1] = 0x01000000;
+    stackTop[-2] = (uint32_t)taskEntry;
+    stackTop[-3] = (uint32_t)taskExitFunction;
+    stackTop[-8] = (uint32_t)params;
+    stackTop[-9] = EXC_RETURN_THREAD_PSP;
+
+    uintptr_t stackPointer = (uintptr_t)(stackTop - 17);
+#endif
+
+    *pTask = (taskHandleType){
+        .stackPointer = stackPointer,
+#if (TASK_STACK_INFO)
+        .stackBase = stack,
+        .stackSize = sizeof(taskSlotStacks[0]),
+#endif
+        .priority = priority,
+        .taskEntry = taskEntry,
+        .params = params,
+        .timeSliceTicks = TASK_TIME_SLICE_TICKS,
+        .remainingSliceTicks = TASK_TIME_SLICE_TICKS,
+        .status = TASK_STATUS_READY,
+        .blockedReason = BLOCK_REASON_NONE,
+        .wakeupReason = WAKEUP_REASON_NONE,
+        .stateNode = {.pTask = pTask},
+        .waitNode = {.pTask = pTask}};
+
+    if (ppTask != NULL)
+    {
+        *ppTask = pTask;
+    }
+
+    ENTER_CRITICAL_SECTION();
+
+    readyQueueAdd(&taskPool.readyQueue, &pTask->stateNode);
+
+    TRACE_EVENT(TRACE_EVENT_TASK_READY, pTask, WAKEUP_REASON_NONE);
+
+    /*Preempt the calling task if the created task has higher priority[lower priority value]*/
+    bool contextSwitchRequired = (taskPool.currentTask != NULL && priority < taskPool.currentTask->priority);
+
+    EXIT_CRITICAL_SECTION();
+
+    if (contextSwitchRequired)
+    {
+        taskYield();
+    }
+
+    return RET_SUCCESS;
+}
+#endif
@@ -27,14 +27,20 @@
 
 #include <assert.h>
 #include "osConfig.h"
+#include "scheduler/scheduler.h"
 #include "taskQueue/taskQueue.h"
+#include "readyQueue/readyQueue.h"
+#include "timeoutQueue/timeoutQueue.h"
+#if (OS_HR_TIMER)
+#include "hrTimer/hrTimer.h"
+#endif
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-#define TASK_LOWEST_PRIORITY 0xff
+#define TASK_LOWEST_PRIORITY (TASK_PRIORITY_LEVELS - 1)
 #define TASK_HIGHEST_PRIORITY 0
 
 #define TASK_NO_WAIT 0
@@ -69,6 +75,68 @@ extern "C"
          |____|                                    |____|
        <-32bits->                                 <-32bits->
       *************************************************************************************/
+
+#define TASK_STACK_INFO ((TASK_STACK_PAINTING) || (TASK_STACK_OVERFLOW_CHECK)) // Task keeps the bounds of its stack
+
+#if (TASK_STACK_OVERFLOW_CHECK)
+#define TASK_STACK_CANARY_WORDS 1
+#define TASK_STACK_CANARY_INITIALIZER [0] = TASK_STACK_CANARY,
+#else
+#define TASK_STACK_CANARY_WORDS 0
+#define TASK_STACK_CANARY_INITIALIZER
+#endif
+
+#if (TASK_STACK_PAINTING)
+/*Paint stack words from above the canary up to lastWord*/
+#define TASK_STACK_PAINT_INITIALIZER(lastWord) [TASK_STACK_CANARY_WORDS ... (lastWord)] = TASK_STACK_PAINT_PATTERN,
+#else
+#define TASK_STACK_PAINT_INITIALIZER(lastWord)
+#endif
+
+#if (TASK_STACK_INFO)
+#define TASK_STACK_INFO_INITIALIZER(name) .stackBase = name##Stack, .stackSize = sizeof(name##Stack),
+#else
+#define TASK_STACK_INFO_INITIALIZER(name)
+#endif
+
+/**
+ * @brief Initializer of the taskHandle struct, common to all ports.
+ */
+#define TASK_HANDLE_INITIALIZER(name, taskStackPointer, taskEntryFunction, taskParams, taskPriority) \
+    {                                                                                                \
+        .stackPointer = (uintptr_t)(taskStackPointer),                                               \
+        TASK_STACK_INFO_INITIALIZER(name)                                                            \
+        .priority = taskPriority,                                                                    \
+        .taskEntry = taskEntryFunction,                                                              \
+        .params = taskParams,                                                                        \
+        .timeoutDeltaTicks = 0,                                                                      \
+        .timeSliceTicks = TASK_TIME_SLICE_TICKS,                                                     \
+        .remainingSliceTicks = TASK_TIME_SLICE_TICKS,                                                \
+        .status = TASK_STATUS_READY,                                                                 \
+        .blockedReason = BLOCK_REASON_NONE,                                                          \
+        .wakeupReason = WAKEUP_REASON_NONE,                                                          \
+        .stateNode = {.pTask = &name, .nextTaskNode = NULL},                                         \
+        .waitNode = {.pTask = &name, .nextTaskNode = NULL}}
+
+#if defined(PLATFORM_POSIX)
+/**
+ * @brief Statically define and initialize a task. On the POSIX port, stackPointer of the task points to its
+ * posixTaskContext struct, which holds the ucontext of the task. Stack is enlarged to POSIX_TASK_MIN_STACK_SIZE
+ * if required, as host library functions and signal frames need much larger stacks than the target.
+ * @param name Name of the task.
+ * @param stackSize Size of task stack in bytes.
+ * @param taskEntryFunction Task  entry  function.
+ * @param taskParams Entry point parameter.
+ * @param taskPriority Task priority.
+ */
+#define TASK_DEFINE(name, stackSize, taskEntryFunction, taskParams, taskPriority)                                      \
+    void taskEntryFunction(void *);                                                                                    \
+    uint32_t name##Stack[POSIX_TASK_STACK_SIZE(stackSize) / sizeof(uint32_t)] = {                                      \
+        TASK_STACK_CANARY_INITIALIZER                                                                                  \
+        TASK_STACK_PAINT_INITIALIZER(POSIX_TASK_STACK_SIZE(stackSize) / sizeof(uint32_t) - 1)};                        \
+    posixTaskContextType name##Context = {.stack = name##Stack, .stackBytes = sizeof(name##Stack), .started = false}; \
+    taskHandleType name = TASK_HANDLE_INITIALIZER(name, &name##Context, taskEntryFunction, taskParams, taskPriority)
+#else
 /**
  * @brief Statically define and initialize a task and its default stack contents.
  * @param name Name of the task.
@@ -77,23 +145,19 @@ extern "C"
  * @param taskParams Entry point parameter.
  * @param taskPriority Task priority.
  */
-#define TASK_DEFINE(name, stackSize, taskEntryFunction, taskParams, taskPriority)    \
-    void taskEntryFunction(void *);                                                  \
-    uint32_t name##Stack[stackSize / sizeof(uint32_t)] = {                           \
-        [stackSize / sizeof(uint32_t) - 1] = 0x01000000,                             \
-        [stackSize / sizeof(uint32_t) - 2] = (uint32_t)taskEntryFunction,            \
-        [stackSize / sizeof(uint32_t) - 3] = (uint32_t)taskExitFunction,             \
-        [stackSize / sizeof(uint32_t) - 8] = (uint32_t)taskParams,                   \
-        [stackSize / sizeof(uint32_t) - 9] = EXC_RETURN_THREAD_PSP};                 \
-    taskHandleType name = {                                                          \
-        .stackPointer = (uint32_t)(name##Stack + stackSize / sizeof(uint32_t) - 17), \
-        .priority = taskPriority,                                                    \
-        .taskEntry = taskEntryFunction,                                              \
-        .params = taskParams,                                                        \
-        .remainingSleepTicks = 0,                                                    \
-        .status = TASK_STATUS_READY,                                                 \
-        .blockedReason = BLOCK_REASON_NONE,                                          \
-        .wakeupReason = WAKEUP_REASON_NONE}
+#define TASK_DEFINE(name, stackSize, taskEntryFunction, taskParams, taskPriority)                   \
+    void taskEntryFunction(void *);                                                                 \
+    uint32_t name##Stack[stackSize / sizeof(uint32_t)] = {                                          \
+        TASK_STACK_CANARY_INITIALIZER                                                               \
+        TASK_STACK_PAINT_INITIALIZER(stackSize / sizeof(uint32_t) - 18)                             \
+        [stackSize / sizeof(uint32_t) - 1] = 0x01000000,                                            \
+        [stackSize / sizeof(uint32_t) - 2] = (uint32_t)taskEntryFunction,                           \
+        [stackSize / sizeof(uint32_t) - 3] = (uint32_t)taskExitFunction,                            \
+        [stackSize / sizeof(uint32_t) - 8] = (uint32_t)taskParams,                                  \
+        [stackSize / sizeof(uint32_t) - 9] = EXC_RETURN_THREAD_PSP};                                \
+    taskHandleType name = TASK_HANDLE_INITIALIZER(name, name##Stack + stackSize / sizeof(uint32_t) - 17, \
+                                                  taskEntryFunction, taskParams, taskPriority)
+#endif
 
     typedef void (*taskFunctionType)(void *params);
 
@@ -102,7 +166,8 @@ extern "C"
         TASK_STATUS_READY,
         TASK_STATUS_RUNNING,
         TASK_STATUS_BLOCKED,
-        TASK_STATUS_SUSPENDED
+        TASK_STATUS_SUSPENDED,
+        TASK_STATUS_DELETED
     } taskStatusType;
 
     typedef enum
@@ -115,6 +180,13 @@ extern "C"
         WAIT_FOR_MSG_QUEUE_SPACE,
         WAIT_FOR_COND_VAR,
         WAIT_FOR_TIMER_TIMEOUT,
+        WAIT_FOR_TASK_EXIT,
+        WAIT_FOR_MEM_POOL_BLOCK,
+        WAIT_FOR_RING_BUFFER_DATA,
+        WAIT_FOR_STREAM_DATA,
+        WAIT_FOR_STREAM_SPACE,
+        WAIT_FOR_EVENT_FLAGS,
+        WAIT_FOR_NOTIFICATION,
 
     } blockedReasonType;
 
@@ -129,28 +201,108 @@ extern "C"
         MSG_QUEUE_SPACE_AVAILABE,
         COND_VAR_SIGNALLED,
         TIMER_TIMEOUT,
-        RESUME
+        RESUME,
+        TASK_EXITED,
+        MEM_POOL_BLOCK_FREED,
+        RING_BUFFER_DATA_AVAILABLE,
+        STREAM_DATA_AVAILABLE,
+        STREAM_SPACE_AVAILABLE,
+        EVENT_FLAGS_SET,
+        NOTIFICATION_RECEIVED
 
     } wakeupReasonType;
 
+#if (TASK_RELEASE_STATS)
+    /*Release statistics of a task released periodically with taskSleepUntil*/
+    typedef struct
+    {
+        uint32_t releaseCount;       // Number of releases
+        uint32_t missedCount;        // Number of releases whose wake tick had already passed when taskSleepUntil was called
+        uint32_t lastLatenessTicks;  // Ticks between the wake tick and the tick at which the task last ran
+        uint32_t maxLatenessTicks;   // Maximum lateness
+        uint64_t totalLatenessTicks; // Sum of latenesses. Average lateness = totalLatenessTicks / releaseCount
+    } taskReleaseStatsType;
+#endif
+
+#if (TASK_RUNTIME_STATS)
+    /*Run time accounting of a task. Run time is counted in the units of the run time counter, i.e. CPU cycles with DWT.*/
+    typedef struct
+    {
+        uint64_t runtimeCycles;          // Total run time
+        uint32_t windowCycles;           // Run time in the current window
+        uint32_t lastWindowCycles;       // Run time in the last complete window
+        uint32_t windowIndex;            // Index of the window which windowCycles belongs to
+        uint32_t voluntarySwitchCount;   // Number of times the task blocked, suspended itself or yielded
+        uint32_t involuntarySwitchCount; // Number of times the task was preempted or its time slice expired
+    } taskRuntimeType;
+
+    typedef struct
+    {
+        uint64_t runtimeCycles;          // Total run time
+        uint32_t cpuUsage;               // CPU usage over the last complete window in hundredths of a percent[0 to 10000]
+        uint32_t voluntarySwitchCount;   // Number of times the task blocked, suspended itself or yielded
+        uint32_t involuntarySwitchCount; // Number of times the task was preempted or its time slice expired
+    } taskRuntimeStatsType;
+#endif
+
+    /*Action performed on the notification value of a task by taskNotify*/
+    typedef enum
+    {
+        TASK_NOTIFY_NO_ACTION,               // Notify without changing the notification value
+        TASK_NOTIFY_SET_BITS,                // Bitwise OR the value into the notification value
+        TASK_NOTIFY_INCREMENT,               // Increment the notification value; the value is ignored
+        TASK_NOTIFY_OVERWRITE,               // Overwrite the notification value with the value
+        TASK_NOTIFY_SET_VALUE_NO_OVERWRITE   // Set the notification value to the value, unless a notification is pending
+    } taskNotifyActionType;
+
+    /*Notification state of a task*/
+    typedef enum
+    {
+        TASK_NOTIFY_STATE_NONE,
+        TASK_NOTIFY_STATE_WAITING, // Task is waiting in taskNotifyWait
+        TASK_NOTIFY_STATE_PENDING  // Task has been notified and has not yet received the notification
+    } taskNotifyStateType;
+
     /*Task control block struct*/
     typedef struct taskHandle
     {
-        uint32_t stackPointer;
+        uintptr_t stackPointer; // Must be the first member. Saved stack pointer of the task, or its context on the POSIX port.
+#if (TASK_STACK_INFO)
+        uint32_t *stackBase; // Must be the second member[checked by PendSV handler]. Lowest address of the stack.
+        uint32_t stackSize;  // Size of the stack in bytes
+#endif
         taskFunctionType taskEntry;
         void *params;
-        uint32_t remainingSleepTicks;
+        uint32_t timeoutDeltaTicks; // Ticks until timeout, relative to the previous task in timeoutQueue
+        uint16_t timeSliceTicks;      // Time slice for round-robin scheduling. 0 if time slicing is disabled for the task.
+        uint16_t remainingSliceTicks; // Ticks remaining in the current time slice
         taskStatusType status;
         blockedReasonType blockedReason;
         wakeupReasonType wakeupReason;
         uint8_t priority;
+        uint8_t eventFlagsOptions; // Wait mode and clear on exit option of the task waiting in eventFlagsWait
+        uint8_t notifyState;       // taskNotifyStateType
+        uint32_t eventFlags;       // Flags awaited in eventFlagsWait, replaced with the flags satisfying the wait
+        uint32_t notifyValue;      // Notification value, updated by taskNotify and received with taskNotifyWait
+        taskNodeType stateNode; // Links the task into readyQueue or timeoutQueue
+        taskNodeType waitNode;  // Links the task into the wait queue of a mutex, semaphore, msgQueue or condVar
+        taskQueueType joinQueue; // Tasks waiting in taskJoin for the task to exit
+#if (TASK_RELEASE_STATS)
+        taskReleaseStatsType releaseStats;
+#endif
+#if (TASK_RUNTIME_STATS)
+        taskRuntimeType runtime;
+#endif
+#if (OS_HR_TIMER)
+        hrAlarmType sleepAlarm; // Alarm waking up the task sleeping in taskSleepUS
+#endif
 
     } taskHandleType;
 
     typedef struct
     {
-        taskQueueType readyQueue;
-        taskQueueType blockedQueue;
+        readyQueueType readyQueue;
+        timeoutQueueType timeoutQueue;
         taskHandleType *currentTask;
 
     } taskPoolType;
@@ -169,50 +321,98 @@ extern "C"
     static inline void taskStart(taskHandleType *pTask)
     {
         assert(pTask != NULL);
+        assert(pTask->priority < TASK_PRIORITY_LEVELS);
 
-        taskQueueAdd(&taskPool.readyQueue, pTask);
+        readyQueueAdd(&taskPool.readyQueue, &pTask->stateNode);
     }
 
     extern void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks);
 
     /**
-     * @brief Block task for specified number of RTOS Ticks
+     * @brief Block task for specified number of RTOS Ticks. Sleeping for 0 ticks yields the CPU to other ready tasks
+     * of equal or higher priority.
      *
      * @param sleepTicks
      */
     static inline void taskSleep(uint32_t sleepTicks)
     {
+        if (sleepTicks == 0)
+        {
+            taskYield();
+            return;
+        }
+
         taskBlock(taskPool.currentTask, SLEEP, sleepTicks);
     }
 
     /**
-     * @brief Block task for specified number of milliseconds
+     * @brief Block task for specified number of milliseconds. Sleep time is rounded up to a whole number of ticks.
      *
      * @param sleepTimeMS
      */
     static inline void taskSleepMS(uint32_t sleepTimeMS)
     {
-        taskSleep(MS_TO_OS_TICKS(sleepTimeMS));
+        taskSleep((uint32_t)(((uint64_t)sleepTimeMS * 1000 + OS_TICK_INTERVAL_US - 1) / OS_TICK_INTERVAL_US));
     }
 
-    /**
-     * @brief Block task for specified number of microseconds
-     *
-     * @param sleepTimeUS
-     */
-    static inline void taskSleepUS(uint32_t sleepTimeUS)
-    {
-        taskSleep(US_TO_OS_TICKS(sleepTimeUS));
-    }
+    void taskSleepUS(uint32_t sleepTimeUS);
+
+    bool taskSleepUntil(uint64_t *pLastWakeTick, uint32_t periodTicks);
+
+#if (TASK_RELEASE_STATS)
+    void taskReleaseStatsGet(taskHandleType *pTask, taskReleaseStatsType *pReleaseStats);
+
+    void taskReleaseStatsReset(taskHandleType *pTask);
+#endif
+
+#if (TASK_STACK_PAINTING)
+    uint32_t taskStackHighWaterMarkGet(taskHandleType *pTask);
+
+    uint32_t schedulerIdleStackHighWaterMarkGet();
+
+    uint32_t schedulerMspHighWaterMarkGet();
+#endif
+
+#if (TASK_STACK_OVERFLOW_CHECK)
+    void taskStackOverflowHandler(taskHandleType *pTask);
+#endif
+
+#if (TASK_RUNTIME_STATS)
+#if !defined(DWT)
+    extern uint32_t runtimeCounterRead(); // Free running 32-bit counter provided by the application on cores without DWT
+#endif
+
+    void taskRuntimeStatsGet(taskHandleType *pTask, taskRuntimeStatsType *pRuntimeStats);
+
+    void schedulerIdleStatsGet(taskRuntimeStatsType *pRuntimeStats);
+#endif
 
     void taskSetReady(taskHandleType *pTask, wakeupReasonType wakeupReason);
 
     void taskBlock(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks);
 
+    void taskBlockUnlocked(taskHandleType *pTask, blockedReasonType blockedReason, uint32_t ticks);
+
     void taskSuspend(taskHandleType *pTask);
 
+    void taskPrioritySet(taskHandleType *pTask, uint8_t priority);
+
+    void taskTimeSliceSet(taskHandleType *pTask, uint16_t timeSliceTicks);
+
     int taskResume(taskHandleType *pTask);
 
+    int taskDelete(taskHandleType *pTask);
+
+    int taskJoin(taskHandleType *pTask, uint32_t waitTicks);
+
+    int taskNotify(taskHandleType *pTask, uint32_t value, taskNotifyActionType action);
+
+    int taskNotifyWait(uint32_t clearMask, uint32_t *pValue, uint32_t waitTicks);
+
+#if (TASK_POOL_SIZE > 0)
+    int taskCreate(taskFunctionType taskEntry, void *params, uint8_t priority, taskHandleType **ppTask);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,81 +23,68 @@
  */
 
 #include <stdint.h>
-#include <stdlib.h>
 #include <assert.h>
 #include "retCodes.h"
 #include "osConfig.h"
 #include "task/task.h"
 #include "taskQueue.h"
-/**
- * @brief Dynamically allocate memory for new task Node.
- *
- * @param pTask Pointer to taskHandle struct
- * @return Pointer to new task node
- */
-static inline taskNodeType *newNode(taskHandleType *pTask)
-{
-    taskNodeType *newTaskNode = (taskNodeType *)malloc(sizeof(taskNodeType));
-
-    assert(newTaskNode != NULL);
-
-    newTaskNode->pTask = pTask;
-    newTaskNode->nextTaskNode = NULL;
-    return newTaskNode;
-}
 
 /**
- * @brief Add task to front of the Queue without sorting
+ * @brief Add task node to front of the Queue without sorting
  *
  * @param pTaskQueue Pointer to the taskQueue struct.
- * @param pTask  Pointer to the taskHandle struct
+ * @param pTaskNode  Pointer to the task node embedded in the taskHandle struct
  */
-void taskQueueAddToFront(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueAddToFront(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
 
-    taskNodeType *newTaskNode = newNode(pTask);
+    pTaskNode->nextTaskNode = pTaskQueue->head;
+    pTaskNode->prevTaskNode = NULL;
+    pTaskNode->pTaskQueue = pTaskQueue;
 
-    newTaskNode->nextTaskNode = pTaskQueue->head;
+    if (pTaskQueue->head != NULL)
+    {
+        pTaskQueue->head->prevTaskNode = pTaskNode;
+    }
 
-    pTaskQueue->head = newTaskNode;
+    pTaskQueue->head = pTaskNode;
 }
 
 /**
- * @brief Add task to Queue and  sort tasks in ascending order of
+ * @brief Add task node to Queue and  sort tasks in ascending order of
  * their priority
- * @param pTaskQueue
- * @param pTask
+ * @param pTaskQueue Pointer to the taskQueue struct.
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
  */
-void taskQueueAdd(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueAdd(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
 
-    taskNodeType *newTaskNode = newNode(pTask);
-
-    if (taskQueueEmpty(pTaskQueue))
+    if (taskQueueEmpty(pTaskQueue) || pTaskQueue->head->pTask->priority > pTaskNode->pTask->priority)
     {
-        pTaskQueue->head = newTaskNode;
-    }
-    else if (pTaskQueue->head->pTask->priority > pTask->priority)
-    {
-        newTaskNode->nextTaskNode = pTaskQueue->head;
-
-        pTaskQueue->head = newTaskNode;
+        taskQueueAddToFront(pTaskQueue, pTaskNode);
     }
     else
     {
         taskNodeType *currentTaskNode = pTaskQueue->head;
-        while (currentTaskNode->nextTaskNode && currentTaskNode->nextTaskNode->pTask->priority <= pTask->priority)
+        while (currentTaskNode->nextTaskNode && currentTaskNode->nextTaskNode->pTask->priority <= pTaskNode->pTask->priority)
         {
             currentTaskNode = currentTaskNode->nextTaskNode;
         }
 
-        newTaskNode->nextTaskNode = currentTaskNode->nextTaskNode;
+        pTaskNode->nextTaskNode = currentTaskNode->nextTaskNode;
+        pTaskNode->prevTaskNode = currentTaskNode;
+        pTaskNode->pTaskQueue = pTaskQueue;
+
+        if (currentTaskNode->nextTaskNode != NULL)
+        {
+            currentTaskNode->nextTaskNode->prevTaskNode = pTaskNode;
+        }
 
-        currentTaskNode->nextTaskNode = newTaskNode;
+        currentTaskNode->nextTaskNode = pTaskNode;
     }
 }
 
@@ -114,61 +101,56 @@ taskHandleType *taskQueueGet(taskQueueType *ptaskQueue)
 
     if (!taskQueueEmpty(ptaskQueue))
     {
-        taskHandleType *pTask = ptaskQueue->head->pTask;
+        taskNodeType *headNode = ptaskQueue->head;
 
-        taskNodeType *temp = ptaskQueue->head->nextTaskNode;
+        ptaskQueue->head = headNode->nextTaskNode;
 
-        free(ptaskQueue->head);
+        if (ptaskQueue->head != NULL)
+        {
+            ptaskQueue->head->prevTaskNode = NULL;
+        }
 
-        ptaskQueue->head = temp;
+        headNode->nextTaskNode = NULL;
+        headNode->pTaskQueue = NULL;
 
-        return pTask;
+        return headNode->pTask;
     }
 
     return NULL;
 }
 
 /**
- * @brief Remove head node from Queue
+ * @brief Remove task node from Queue. Nothing is done if the node is not in the Queue.
  *
- * @param pTaskQueue
- */
-static inline void taskQueueRemoveHead(taskQueueType *pTaskQueue)
-{
-    taskNodeType *temp = pTaskQueue->head->nextTaskNode;
-
-    free(pTaskQueue->head);
-
-    pTaskQueue->head = temp;
-}
-
-/**
- * @brief Remove task from Queue
- *
- * @param pTaskQueue
- * @param pTask
+ * @param pTaskQueue Pointer to taskQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
  */
-void taskQueueRemove(taskQueueType *pTaskQueue, taskHandleType *pTask)
+void taskQueueRemove(taskQueueType *pTaskQueue, taskNodeType *pTaskNode)
 {
     assert(pTaskQueue != NULL);
-    assert(pTask != NULL);
+    assert(pTaskNode != NULL);
 
-    if (pTask == pTaskQueue->head->pTask)
+    /*Task node not linked to this Queue*/
+    if (pTaskNode->pTaskQueue != pTaskQueue)
     {
-        taskQueueRemoveHead(pTaskQueue);
+        return;
     }
 
+    if (pTaskNode->prevTaskNode != NULL)
+    {
+        pTaskNode->prevTaskNode->nextTaskNode = pTaskNode->nextTaskNode;
+    }
     else
     {
-        taskNodeType *currentTaskNode = pTaskQueue->head;
-
-        while (currentTaskNode->nextTaskNode->pTask != pTask)
-            currentTaskNode = currentTaskNode->nextTaskNode;
-
-        taskNodeType *temp = currentTaskNode->nextTaskNode->nextTaskNode;
-
-        free(currentTaskNode->nextTaskNode);
+        pTaskQueue->head = pTaskNode->nextTaskNode;
+    }
 
-        currentTaskNode->nextTaskNode = temp;
+    if (pTaskNode->nextTaskNode != NULL)
+    {
+        pTaskNode->nextTaskNode->prevTaskNode = pTaskNode->prevTaskNode;
     }
-}
\ No newline at end of file
+
+    pTaskNode->nextTaskNode = NULL;
+    pTaskNode->prevTaskNode = NULL;
+    pTaskNode->pTaskQueue = NULL;
+}
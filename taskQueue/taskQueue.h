@@ -34,24 +34,28 @@ extern "C"
     /*Forward declaration of taskHandleType*/
     typedef struct taskHandle taskHandleType;
 
+    /*Task queue link node. Nodes are embedded in the taskHandle struct itself, so adding a task to
+    a queue never allocates memory.*/
     typedef struct taskNode
     {
         taskHandleType *pTask;
         struct taskNode *nextTaskNode;
+        struct taskNode *prevTaskNode;
+        struct taskQueue *pTaskQueue; // taskQueue holding the node. NULL if the node is not in a taskQueue.
     } taskNodeType;
 
-    typedef struct
+    typedef struct taskQueue
     {
         taskNodeType *head;
     } taskQueueType;
 
     taskHandleType *taskQueueGet(taskQueueType *pTaskQueue);
 
-    void taskQueueAdd(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueAdd(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
-    void taskQueueAddToFront(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueAddToFront(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
-    void taskQueueRemove(taskQueueType *pTaskQueue, taskHandleType *pTask);
+    void taskQueueRemove(taskQueueType *pTaskQueue, taskNodeType *pTaskNode);
 
     /**
      * @brief Check if taskQueue is empty
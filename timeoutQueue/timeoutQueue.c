@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <assert.h>
+#include "osConfig.h"
+#include "task/task.h"
+#include "taskQueue/taskQueue.h"
+#include "timeoutQueue.h"
+
+/**
+ * @brief Add task node to the timeoutQueue in order of its deadline. Tasks having the same deadline
+ * are kept in First In First Out(FIFO) order.
+ *
+ * @param pTimeoutQueue Pointer to the timeoutQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
+ * @param ticks Number of ticks from now until the timeout
+ */
+void timeoutQueueAdd(timeoutQueueType *pTimeoutQueue, taskNodeType *pTaskNode, uint32_t ticks)
+{
+    assert(pTimeoutQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    taskNodeType *prevTaskNode = NULL;
+    taskNodeType *currentTaskNode = pTimeoutQueue->head;
+
+    /*Find the position of the task node, converting ticks relative to the deadline of the previous node*/
+    while (currentTaskNode != NULL && currentTaskNode->pTask->timeoutDeltaTicks <= ticks)
+    {
+        ticks -= currentTaskNode->pTask->timeoutDeltaTicks;
+        prevTaskNode = currentTaskNode;
+        currentTaskNode = currentTaskNode->nextTaskNode;
+    }
+
+    pTaskNode->pTask->timeoutDeltaTicks = ticks;
+    pTaskNode->prevTaskNode = prevTaskNode;
+    pTaskNode->nextTaskNode = currentTaskNode;
+
+    if (currentTaskNode != NULL)
+    {
+        /*Deadline of the next node is now relative to the inserted node*/
+        currentTaskNode->pTask->timeoutDeltaTicks -= ticks;
+        currentTaskNode->prevTaskNode = pTaskNode;
+    }
+
+    if (prevTaskNode != NULL)
+    {
+        prevTaskNode->nextTaskNode = pTaskNode;
+    }
+    else
+    {
+        pTimeoutQueue->head = pTaskNode;
+    }
+}
+
+/**
+ * @brief Remove task node from the timeoutQueue. Nothing is done if the node is not in the timeoutQueue.
+ *
+ * @param pTimeoutQueue Pointer to the timeoutQueue struct
+ * @param pTaskNode Pointer to the task node embedded in the taskHandle struct
+ */
+void timeoutQueueRemove(timeoutQueueType *pTimeoutQueue, taskNodeType *pTaskNode)
+{
+    assert(pTimeoutQueue != NULL);
+    assert(pTaskNode != NULL);
+
+    if (pTaskNode->prevTaskNode != NULL)
+    {
+        pTaskNode->prevTaskNode->nextTaskNode = pTaskNode->nextTaskNode;
+    }
+    else if (pTimeoutQueue->head == pTaskNode)
+    {
+        pTimeoutQueue->head = pTaskNode->nextTaskNode;
+    }
+    else
+    {
+        /*Task node is not in the timeoutQueue*/
+        return;
+    }
+
+    if (pTaskNode->nextTaskNode != NULL)
+    {
+        /*Give remaining ticks of the removed node to the next node to keep its deadline unchanged*/
+        pTaskNode->nextTaskNode->pTask->timeoutDeltaTicks += pTaskNode->pTask->timeoutDeltaTicks;
+        pTaskNode->nextTaskNode->prevTaskNode = pTaskNode->prevTaskNode;
+    }
+
+    pTaskNode->pTask->timeoutDeltaTicks = 0;
+    pTaskNode->nextTaskNode = NULL;
+    pTaskNode->prevTaskNode = NULL;
+}
+
+/**
+ * @brief Advance time of the timeoutQueue by specified number of ticks. Task nodes whose deadline has
+ * been reached are left at the front of the queue with zero remaining ticks; they can be fetched using
+ * timeoutQueueGetExpired.
+ *
+ * @param pTimeoutQueue Pointer to the timeoutQueue struct
+ * @param ticks Number of elapsed ticks
+ */
+void timeoutQueueAdvance(timeoutQueueType *pTimeoutQueue, uint32_t ticks)
+{
+    assert(pTimeoutQueue != NULL);
+
+    taskNodeType *currentTaskNode = pTimeoutQueue->head;
+
+    while (currentTaskNode != NULL && ticks != 0)
+    {
+        if (currentTaskNode->pTask->timeoutDeltaTicks > ticks)
+        {
+            currentTaskNode->pTask->timeoutDeltaTicks -= ticks;
+            break;
+        }
+
+        ticks -= currentTaskNode->pTask->timeoutDeltaTicks;
+        currentTaskNode->pTask->timeoutDeltaTicks = 0;
+        currentTaskNode = currentTaskNode->nextTaskNode;
+    }
+}
+
+/**
+ * @brief Get a task whose deadline has been reached and remove it from the timeoutQueue
+ *
+ * @param pTimeoutQueue Pointer to the timeoutQueue struct
+ * @retval Task whose timeout expired if exists
+ * @retval NULL if no timeout has expired
+ */
+taskHandleType *timeoutQueueGetExpired(timeoutQueueType *pTimeoutQueue)
+{
+    assert(pTimeoutQueue != NULL);
+
+    taskNodeType *headNode = pTimeoutQueue->head;
+
+    if (headNode == NULL || headNode->pTask->timeoutDeltaTicks != 0)
+    {
+        return NULL;
+    }
+
+    pTimeoutQueue->head = headNode->nextTaskNode;
+
+    if (pTimeoutQueue->head != NULL)
+    {
+        pTimeoutQueue->head->prevTaskNode = NULL;
+    }
+
+    headNode->nextTaskNode = NULL;
+
+    return headNode->pTask;
+}
+
+/**
+ * @brief Get number of ticks until the earliest timeout in the timeoutQueue
+ *
+ * @param pTimeoutQueue Pointer to the timeoutQueue struct
+ * @retval Number of ticks until the earliest timeout
+ * @retval UINT32_MAX if timeoutQueue is empty
+ */
+uint32_t timeoutQueueNextTimeoutTicks(timeoutQueueType *pTimeoutQueue)
+{
+    assert(pTimeoutQueue != NULL);
+
+    return (pTimeoutQueue->head == NULL) ? UINT32_MAX : pTimeoutQueue->head->pTask->timeoutDeltaTicks;
+}
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SANO_RTOS_TIMEOUT_QUEUE_H
+#define __SANO_RTOS_TIMEOUT_QUEUE_H
+
+#include "osConfig.h"
+#include "taskQueue/taskQueue.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /*Queue of blocked tasks waiting with a timeout, sorted in ascending order of their deadline. Each task
+    stores its timeout as a number of ticks relative to the deadline of the previous task in the queue(delta
+    encoding); hence, only the head of the queue needs to be updated on every tick.*/
+    typedef struct
+    {
+        taskNodeType *head;
+    } timeoutQueueType;
+
+    void timeoutQueueAdd(timeoutQueueType *pTimeoutQueue, taskNodeType *pTaskNode, uint32_t ticks);
+
+    void timeoutQueueRemove(timeoutQueueType *pTimeoutQueue, taskNodeType *pTaskNode);
+
+    void timeoutQueueAdvance(timeoutQueueType *pTimeoutQueue, uint32_t ticks);
+
+    taskHandleType *timeoutQueueGetExpired(timeoutQueueType *pTimeoutQueue);
+
+    uint32_t timeoutQueueNextTimeoutTicks(timeoutQueueType *pTimeoutQueue);
+
+    /**
+     * @brief Check if timeoutQueue is empty
+     *
+     * @param pTimeoutQueue Pointer to the timeoutQueue struct
+     * @retval true if timeoutQueue is empty
+     * @retval false, otherwise
+     */
+    static inline bool timeoutQueueEmpty(timeoutQueueType *pTimeoutQueue)
+    {
+        return pTimeoutQueue->head == NULL;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -25,130 +25,205 @@
 #include <stdbool.h>
 #include <assert.h>
 #include <stdint.h>
-#include <stdlib.h>
 #include "retCodes.h"
 #include "scheduler/scheduler.h"
 #include "task/task.h"
+#include "trace/trace.h"
 #include "timer.h"
 
 #define TIMER_TASK_PRIORITY TASK_HIGHEST_PRIORITY // timer task has the highest possible priority [lower the value, higher the priority]
 
-static timerListType timerList = {0}; // List of running timers
+static timerWheelType timerWheel = {0}; // Timing wheel of running timers
 
-static timeoutHandlerQueueType timeoutHandlerQueue = {0}; // Queue of timeout handlers to be executed
+static expiredTimerQueueType expiredTimerQueue = {0}; // Queue of expired timers whose timeout handlers are to be executed
 
 /*Define timer task with highest possible priority*/
-TASK_DEFINE(timerTask, 1024, timerTaskFunction, NULL, TIMER_TASK_PRIORITY);
+TASK_DEFINE(timerTask, TIMER_TASK_STACK_SIZE, timerTaskFunction, NULL, TIMER_TASK_PRIORITY);
 
 /**
- * @brief Insert timeoutHandler node at the end of the Queue
+ * @brief Add an expired timer to the end of the Queue of expired timers. If the timer is already in the Queue, only its
+ * number of pending expiries is incremented; hence, no memory is allocated.
  *
- * @param pTimeoutHandlerQueue Pointer to the timeoutHandlerQueue struct
- * @param timeoutHandler timeoutHandler function
+ * @param pExpiredTimerQueue Pointer to the expiredTimerQueue struct
+ * @param pTimerNode Pointer to the expired timerNode struct
  */
-static void timeoutHandlerQueuePush(timeoutHandlerQueueType *pTimeoutHandlerQueue, timeoutHandlerType timeoutHandler)
+static void expiredTimerQueuePush(expiredTimerQueueType *pExpiredTimerQueue, timerNodeType *pTimerNode)
 {
-    timeoutHandlerNodeType *newNode = (timeoutHandlerNodeType *)malloc(sizeof(timeoutHandlerNodeType));
+    TRACE_EVENT(TRACE_EVENT_TIMER_EXPIRY, pTimerNode, 0);
 
-    assert(newNode != NULL);
+    if (pTimerNode->pendingCount++ != 0)
+    {
+        return;
+    }
 
-    newNode->timeoutHandler = timeoutHandler;
-    newNode->nextNode = NULL;
+    pTimerNode->nextExpiredNode = NULL;
 
-    if (pTimeoutHandlerQueue->head == NULL)
+    if (pExpiredTimerQueue->head == NULL)
     {
-        pTimeoutHandlerQueue->head = newNode;
-        pTimeoutHandlerQueue->tail = pTimeoutHandlerQueue->head;
+        pExpiredTimerQueue->head = pTimerNode;
+        pExpiredTimerQueue->tail = pExpiredTimerQueue->head;
     }
     else
     {
-        pTimeoutHandlerQueue->tail->nextNode = newNode;
-        pTimeoutHandlerQueue->tail = newNode;
+        pExpiredTimerQueue->tail->nextExpiredNode = pTimerNode;
+        pExpiredTimerQueue->tail = pTimerNode;
+    }
+}
+
+/**
+ * @brief Get expired timer from the front of the Queue
+ *
+ * @param pExpiredTimerQueue Pointer to the expiredTimerQueue struct
+ * @retval Pointer to the expired timerNode struct
+ * @retval NULL if Queue is empty
+ */
+static timerNodeType *expiredTimerQueuePop(expiredTimerQueueType *pExpiredTimerQueue)
+{
+    timerNodeType *pTimerNode = pExpiredTimerQueue->head;
+
+    if (pTimerNode != NULL)
+    {
+        pExpiredTimerQueue->head = pTimerNode->nextExpiredNode;
+
+        pTimerNode->nextExpiredNode = NULL;
     }
+
+    return pTimerNode;
 }
 
 /**
- * @brief Get timeoutHandler node from the front of the Queue
+ * @brief Add a timer node to the timer wheel slot corresponding to its expiry tick.
  *
- * @param pTimeoutHandlerQueue
- * @retval timeoutHandler function
+ * @param pTimerNode Pointer to the timerNode struct
  */
-static timeoutHandlerType timeoutHandlerQueuePop(timeoutHandlerQueueType *pTimeoutHandlerQueue)
+static void timerWheelAdd(timerNodeType *pTimerNode)
 {
+    uint32_t ticksToExpire = pTimerNode->expiryTick - timerWheel.currentTick;
+    uint32_t slotTick = pTimerNode->expiryTick;
+    uint32_t level = 0;
+
+    /*Find the lowest level whose range covers the ticks to expire*/
+    while (level < (TIMER_WHEEL_LEVELS - 1) && ticksToExpire >= (1UL << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+    {
+        level++;
+    }
 
-    timeoutHandlerNodeType *temp = pTimeoutHandlerQueue->head->nextNode;
+    /*Timer expiring beyond the range of the wheel is kept in the farthest slot of the top level.
+     It is re-inserted at its actual expiry tick when that slot is cascaded.*/
+    if (ticksToExpire >= TIMER_WHEEL_RANGE)
+    {
+        slotTick = timerWheel.currentTick + TIMER_WHEEL_RANGE - 1;
+    }
 
-    timeoutHandlerType timeoutHandler = pTimeoutHandlerQueue->head->timeoutHandler;
+    timerNodeType **pSlot = &timerWheel.slot[level][(slotTick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK];
 
-    free(pTimeoutHandlerQueue->head);
+    pTimerNode->pWheelSlot = pSlot;
+    pTimerNode->prevNode = NULL;
+    pTimerNode->nextNode = *pSlot;
 
-    pTimeoutHandlerQueue->head = temp;
+    if (*pSlot != NULL)
+    {
+        (*pSlot)->prevNode = pTimerNode;
+    }
 
-    return timeoutHandler;
+    *pSlot = pTimerNode;
 }
 
 /**
- * @brief Add a timer node to the list of running timers
+ * @brief Remove a timer node from its timer wheel slot
  *
- * @param pTimerList  Pointer to the timer list struct
- * @param pTimerNode  Pointer to the timerNode struct
+ * @param pTimerNode Pointer to the timerNode struct
  */
-static void timerListNodeAdd(timerListType *pTimerList, timerNodeType *pTimerNode)
+static void timerWheelRemove(timerNodeType *pTimerNode)
 {
+    if (pTimerNode->prevNode != NULL)
+    {
+        pTimerNode->prevNode->nextNode = pTimerNode->nextNode;
+    }
+    else
+    {
+        *pTimerNode->pWheelSlot = pTimerNode->nextNode;
+    }
 
-    pTimerNode->nextNode = pTimerList->head;
+    if (pTimerNode->nextNode != NULL)
+    {
+        pTimerNode->nextNode->prevNode = pTimerNode->prevNode;
+    }
 
-    pTimerList->head = pTimerNode;
+    pTimerNode->nextNode = NULL;
+    pTimerNode->prevNode = NULL;
+    pTimerNode->pWheelSlot = NULL;
 }
 
 /**
- * @brief Delete the timerNode from the beginning of the list
+ * @brief Move all timers of the specified slot of an upper level to the levels below
  *
- * @param pTimerList Pointer to the timerNode struct
+ * @param level Level of the timer wheel
+ * @param index Slot index
  */
-static inline void timerListDeleteFirstNode(timerListType *pTimerList)
+static void timerWheelCascade(uint32_t level, uint32_t index)
 {
-    timerNodeType *tempNode = pTimerList->head->nextNode;
+    timerNodeType *currentNode = timerWheel.slot[level][index];
+
+    timerWheel.slot[level][index] = NULL;
+
+    while (currentNode != NULL)
+    {
+        /*Save next node as it is overwritten while re-inserting the current node*/
+        timerNodeType *nextNode = currentNode->nextNode;
 
-    pTimerList->head->nextNode = NULL;
+        timerWheelAdd(currentNode);
 
-    pTimerList->head = tempNode;
+        currentNode = nextNode;
+    }
 }
 
 /**
- * @brief Delete a specified timerNode from the list of running timers.
+ * @brief Start a timer without entering critical section.
  *
- * @param pTimerList Pointer to the timerList struct.
- * @param pTimerNode Pointer to the timerNode struct.
- * @retval RET_SUCCESS if timerNode deleted successfully
- * @retval RET_EMPTY if timerList is empty
+ * @param pTimerNode Pointer timerNode struct
+ * @param expiryTick Tick of the timer wheel at which the timer expires. Must be later than the current tick.
+ * @param intervalTicks Timer intervalTicks
  */
-static int timerListNodeDelete(timerListType *pTimerList, timerNodeType *pTimerNode)
+static void timerStartUnlocked(timerNodeType *pTimerNode, uint32_t expiryTick, uint32_t intervalTicks)
 {
+    /* Set isRunning flag for the started timer pTimerNode.*/
+    pTimerNode->isRunning = true;
 
-    if (pTimerList->head != NULL) // Check if timerList is empty
-    {
-        timerNodeType *currentNode = pTimerList->head;
+    pTimerNode->intervalTicks = intervalTicks;
 
-        /* If the timer correponds to the head node in the list, remove the timer node and reassign head node.*/
-        if (pTimerNode == pTimerList->head)
-            timerListDeleteFirstNode(pTimerList);
+    pTimerNode->expiryTick = expiryTick;
 
-        else
-        {
-            while (currentNode->nextNode != pTimerNode)
-                currentNode = currentNode->nextNode;
+    timerWheelAdd(pTimerNode);
 
-            currentNode->nextNode = pTimerNode->nextNode;
-            pTimerNode->nextNode = NULL;
-        }
-        return RET_SUCCESS;
+    timerWheel.timerCount++;
+}
+
+/**
+ * @brief Stop a timer without entering critical section.
+ *
+ * @param pTimerNode Pointer timerNode struct
+ */
+static void timerStopUnlocked(timerNodeType *pTimerNode)
+{
+    pTimerNode->isRunning = false;
+
+#if (OS_HR_TIMER)
+    /*Timer started with timerStartUS is driven by its alarm instead of the timer wheel*/
+    if (pTimerNode->alarm.isArmed)
+    {
+        hrAlarmStop(&pTimerNode->alarm);
+        return;
     }
-    return RET_EMPTY;
+#endif
+
+    timerWheelRemove(pTimerNode);
+
+    timerWheel.timerCount--;
 }
 
 /**
- * @brief  Function to start the timer. This stores the timerNode in the list of running timers.
+ * @brief  Function to start the timer. This stores the timerNode in the timer wheel of running timers.
  *
  * @param pTimerNode Pointer timerNode struct
  * @param intervalTicks Timer intervalTicks
@@ -159,80 +234,288 @@ int timerStart(timerNodeType *pTimerNode, uint32_t intervalTicks)
 {
     assert(pTimerNode != NULL);
 
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
     /* check if the timer is already in running state. If so, abort re-starting the timer.*/
     if (pTimerNode->isRunning)
-        return RET_ALREADYACTIVE;
+    {
+        retCode = RET_ALREADYACTIVE;
+    }
+    else
+    {
+        /*Timer can expire at the next tick at the earliest*/
+        timerStartUnlocked(pTimerNode, timerWheel.currentTick + (intervalTicks != 0 ? intervalTicks : 1), intervalTicks);
 
-    /* Set isRunning flag for the started timer pTimerNode.*/
-    pTimerNode->isRunning = true;
+        retCode = RET_SUCCESS;
+    }
 
-    pTimerNode->ticksToExpire = pTimerNode->intervalTicks = intervalTicks;
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Function to start the timer to first expire at the specified absolute tick. A periodic timer then expires every
+ * intervalTicks after that tick. This allows timers to be phase aligned with each other and with tasks released using
+ * taskSleepUntil.
+ *
+ * @param pTimerNode Pointer timerNode struct
+ * @param firstExpiryTick Tick count[see schedulerTickCountGet] at which the timer first expires
+ * @param intervalTicks Timer intervalTicks
+ * @retval RET_SUCCESS if timer started successfully
+ * @retval RET_ALREADYACTIVE if timer is already running
+ * @retval RET_INVAL if firstExpiryTick has already passed or is too far in the future
+ */
+int timerStartAt(timerNodeType *pTimerNode, uint64_t firstExpiryTick, uint32_t intervalTicks)
+{
+    assert(pTimerNode != NULL);
 
-    /* Add the timer in the queue of running timers*/
-    timerListNodeAdd(&timerList, pTimerNode);
+    int retCode;
 
-    return RET_SUCCESS;
+    ENTER_CRITICAL_SECTION();
+
+    uint64_t tickCount = schedulerTickCountGet();
+
+    if (pTimerNode->isRunning)
+    {
+        retCode = RET_ALREADYACTIVE;
+    }
+    else if (firstExpiryTick <= tickCount || (firstExpiryTick - tickCount) > UINT32_MAX)
+    {
+        retCode = RET_INVAL;
+    }
+    else
+    {
+        /*Timer wheel and tick count are advanced together; hence, the offset from the current tick is the same for both*/
+        timerStartUnlocked(pTimerNode, timerWheel.currentTick + (uint32_t)(firstExpiryTick - tickCount), intervalTicks);
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
 }
 
+#if (OS_HR_TIMER)
+/**
+ * @brief Alarm callback of the timer started with timerStartUS. This is executed from interrupt context.
+ *
+ * @param pAlarm Pointer to the hrAlarm struct of the timer
+ */
+static void timerAlarmCallback(hrAlarmType *pAlarm)
+{
+    timerNodeType *pTimerNode = (timerNodeType *)pAlarm->context;
+
+    /*Add timer to the expiredTimerQueue*/
+    expiredTimerQueuePush(&expiredTimerQueue, pTimerNode);
+
+    if (timerTask.status != TASK_STATUS_READY)
+        taskSetReady(&timerTask, TIMER_TIMEOUT);
+
+    /* Re-arm periodic timer relative to the previous deadline to avoid drift*/
+    if (pTimerNode->mode == TIMER_MODE_PERIODIC)
+        hrAlarmStart(pAlarm, pAlarm->deadlineCycles + pTimerNode->intervalCycles, timerAlarmCallback, pTimerNode);
+    else
+        pTimerNode->isRunning = false;
+}
+
+/**
+ * @brief Function to start the timer with an interval in microseconds. The timer is driven by a high resolution alarm
+ * instead of the timer wheel; hence, the interval is not limited to whole ticks.
+ *
+ * @param pTimerNode Pointer timerNode struct
+ * @param intervalUS Timer interval in microseconds
+ * @retval RET_SUCCESS if timer started successfully
+ * @retval RET_ALREADYACTIVE if timer is already running
+ */
+int timerStartUS(timerNodeType *pTimerNode, uint32_t intervalUS)
+{
+    assert(pTimerNode != NULL);
+
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
+    if (pTimerNode->isRunning)
+    {
+        retCode = RET_ALREADYACTIVE;
+    }
+    else
+    {
+        /*Periodic timer must advance by at least one cycle*/
+        uint64_t intervalCycles = (uint64_t)intervalUS * SystemCoreClock / 1000000;
+
+        pTimerNode->intervalCycles = (intervalCycles != 0) ? intervalCycles : 1;
+
+        pTimerNode->isRunning = true;
+
+        hrAlarmStart(&pTimerNode->alarm, hrTimerCyclesGet() + pTimerNode->intervalCycles, timerAlarmCallback, pTimerNode);
+
+        retCode = RET_SUCCESS;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+#endif
+
 /**
  * @brief Function to stop the specified timerNode. This sets isRunning flag to false to prevent subsequent events from this timer
- *  and delete timer from the list of running timers
+ *  and delete timer from the timer wheel of running timers
  *
  * @param pTimerNode Pointer to timerNode struct
  * @retval RET_SUCCESS if timer stopped successfully
- * @retval RET_EMPTY if timerList is empty
  * @retval RET_NOTACTIVE if timer is not running
  */
 int timerStop(timerNodeType *pTimerNode)
 {
     assert(pTimerNode != NULL);
 
+    int retCode;
+
+    ENTER_CRITICAL_SECTION();
+
     if (pTimerNode->isRunning)
     {
-        pTimerNode->isRunning = false;
-        return timerListNodeDelete(&timerList, pTimerNode);
+        timerStopUnlocked(pTimerNode);
+
+        retCode = RET_SUCCESS;
+    }
+    else
+    {
+        retCode = RET_NOTACTIVE;
+    }
+
+    EXIT_CRITICAL_SECTION();
+
+    return retCode;
+}
+
+/**
+ * @brief Advance the timer wheel by one tick and add timeout handlers of the expired timers to the
+ * Queue of timeout handlers
+ */
+static void timerWheelTick()
+{
+    timerWheel.currentTick++;
+
+    uint32_t index = timerWheel.currentTick & TIMER_WHEEL_SLOT_MASK;
+
+    /*Cascade timers from upper levels whenever index of the level below wraps around*/
+    if (index == 0)
+    {
+        for (uint32_t level = 1; level < TIMER_WHEEL_LEVELS; level++)
+        {
+            uint32_t levelIndex = (timerWheel.currentTick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+
+            timerWheelCascade(level, levelIndex);
+
+            if (levelIndex != 0)
+                break;
+        }
+    }
+
+    timerNodeType *currentNode;
+
+    /*All timers in the current slot of the first level have expired*/
+    while ((currentNode = timerWheel.slot[0][index]) != NULL)
+    {
+        timerStopUnlocked(currentNode);
+
+        /*Add timer to the expiredTimerQueue*/
+        expiredTimerQueuePush(&expiredTimerQueue, currentNode);
+
+        /* Make timer task ready to allow execution*/
+        if (timerTask.status != TASK_STATUS_READY)
+            taskSetReady(&timerTask, TIMER_TIMEOUT);
+
+        /* Restart periodic timer for the next event. Next expiry is anchored to the previous expiry tick rather than to the
+        time the timer is processed; hence, periodic timers do not drift.*/
+        if (currentNode->mode == TIMER_MODE_PERIODIC)
+            timerStartUnlocked(currentNode, currentNode->expiryTick + (currentNode->intervalTicks != 0 ? currentNode->intervalTicks : 1),
+                               currentNode->intervalTicks);
     }
-    return RET_NOTACTIVE;
 }
 
 /**
  * @brief Check for timer timeout and add the corresponding timeout handler to the
  *  Queue of timeout handlers
+ * @param elapsedTicks Number of ticks elapsed since timers were last processed
  */
-void processTimers()
+void processTimers(uint32_t elapsedTicks)
 {
-    if (timerList.head != NULL) // Check if timer list is empty
+    /*Nothing to expire or cascade if no timer is running*/
+    if (timerWheel.timerCount == 0)
+    {
+        timerWheel.currentTick += elapsedTicks;
+        return;
+    }
+
+    while (elapsedTicks--)
+    {
+        timerWheelTick();
+    }
+}
+
+/**
+ * @brief Get number of ticks until the next running timer expires.
+ *
+ * @retval Number of ticks until the next timer expiry
+ * @retval UINT32_MAX if no timer is running
+ */
+uint32_t timerNextExpiryTicks()
+{
+    uint32_t nextExpiryTicks = UINT32_MAX;
+
+    if (timerWheel.timerCount == 0)
+    {
+        return nextExpiryTicks;
+    }
+
+    /*Slots of a level cover consecutive tick ranges starting from the slot after the current one and wrapping around up to
+    the current slot itself. Hence, the earliest timer of a level is in the first non-empty slot in this order.*/
+    for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++)
     {
-        timerNodeType *currentNode = timerList.head;
-        while (currentNode != NULL)
+        uint32_t shift = level * TIMER_WHEEL_SLOT_BITS;
+        uint32_t currentIndex = (timerWheel.currentTick >> shift) & TIMER_WHEEL_SLOT_MASK;
+
+        for (uint32_t i = 1; i <= TIMER_WHEEL_SLOTS; i++)
         {
-            /*Save next node to avoid losing track of linked list after a time node is deleted while stopping the timer*/
-            timerNodeType *nextNode = currentNode->nextNode;
+            timerNodeType *currentNode = timerWheel.slot[level][(currentIndex + i) & TIMER_WHEEL_SLOT_MASK];
 
-            /*Decrement ticks to expire*/
-            if (currentNode->ticksToExpire > 0)
-                currentNode->ticksToExpire--;
+            if (currentNode == NULL)
+                continue;
 
-            /* Check if timer has expired.If set, call the timeoutHandler() and update the ticksToExpire for next event.*/
-            if (currentNode->ticksToExpire == 0)
+            if (level == TIMER_WHEEL_LEVELS - 1)
             {
+                /*Top level also holds timers expiring beyond the range of the wheel, which break the order of slots.
+                Use the tick at which the slot is cascaded instead, which is never later than any timer in the level.*/
+                uint32_t cascadeTicks = (((timerWheel.currentTick >> shift) + i) << shift) - timerWheel.currentTick;
 
-                /*Add timeout handler to the timeoutHandlerQueue*/
-                timeoutHandlerQueuePush(&timeoutHandlerQueue, currentNode->timeoutHandler);
-
-                /* Check if timer task is suspended. If so, change status to ready to allow execution.*/
-                if (timerTask.status == TASK_STATUS_BLOCKED)
-                    taskSetReady(&timerTask, TIMER_TIMEOUT);
+                if (cascadeTicks < nextExpiryTicks)
+                    nextExpiryTicks = cascadeTicks;
+            }
+            else
+            {
+                while (currentNode != NULL)
+                {
+                    uint32_t ticksToExpire = currentNode->expiryTick - timerWheel.currentTick;
 
-                currentNode->ticksToExpire = currentNode->intervalTicks;
+                    if (ticksToExpire < nextExpiryTicks)
+                        nextExpiryTicks = ticksToExpire;
 
-                /* Check if the timer mode is SINGLE_SHOT. If true, stop the correponding timer*/
-                if (currentNode->mode == TIMER_MODE_SINGLE_SHOT)
-                    timerStop(currentNode);
+                    currentNode = currentNode->nextNode;
+                }
             }
-            currentNode = nextNode;
+            break;
         }
     }
+
+    return nextExpiryTicks;
 }
 
 /**
@@ -245,6 +528,18 @@ void timerTaskStart()
     taskStart(&timerTask);
 }
 
+#if (TASK_STACK_PAINTING)
+/**
+ * @brief Get high-water mark of the timer task stack. Timeout handlers execute on this stack.
+ *
+ * @return Maximum stack usage in bytes
+ */
+uint32_t timerTaskStackHighWaterMarkGet()
+{
+    return taskStackHighWaterMarkGet(&timerTask);
+}
+#endif
+
 /**
  * @brief RTOS timer task function
  *
@@ -256,15 +551,38 @@ void timerTaskFunction(void *args)
 
     while (1)
     {
-        if (timeoutHandlerQueue.head != NULL) // Check for non-empty condition
+        uint32_t pendingCount = 0;
+
+        ENTER_CRITICAL_SECTION();
+
+        timerNodeType *pTimerNode = expiredTimerQueuePop(&expiredTimerQueue);
+
+        if (pTimerNode != NULL)
+        {
+            pendingCount = pTimerNode->pendingCount;
+            pTimerNode->pendingCount = 0;
+        }
+        else
         {
-            timeoutHandlerType timeoutHandler = timeoutHandlerQueuePop(&timeoutHandlerQueue);
-            timeoutHandler();
+            /* Block timer task in the same critical section in which the expiredTimerQueue was found empty, so that
+            a timer expiring meanwhile cannot be missed*/
+            taskBlockUnlocked(&timerTask, WAIT_FOR_TIMER_TIMEOUT, 0);
+        }
+
+        EXIT_CRITICAL_SECTION();
+
+        if (pTimerNode != NULL)
+        {
+            /*Execute timeout handler once for every expiry of the timer*/
+            while (pendingCount--)
+            {
+                pTimerNode->timeoutHandler(pTimerNode->context);
+            }
         }
         else
         {
-            /* Block timer task and give cpu to other tasks while waiting for timeout*/
-            taskBlock(&timerTask, WAIT_FOR_TIMER_TIMEOUT, 0);
+            /* Give cpu to other tasks while waiting for timeout*/
+            taskYield();
         }
     }
 }
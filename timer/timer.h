@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "osConfig.h"
+#include "hrTimer/hrTimer.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -45,58 +46,93 @@ extern "C"
  * @param name Name of the timer.
  * @param timeout_handler Function to execute on timer timeout.
  * @param timer_mode Timer mode[PERIODIC or SINGLE_SHOT].
+ * @param timer_context Pointer passed to the timeout handler. This allows a single handler to serve many timers.
  *
  */
-#define TIMER_DEFINE(name, timeout_handler, timer_mode) \
-    void timeout_handler(void);                         \
-    timerNodeType name = {                              \
-        .isRunning = false,                             \
-        .mode = timer_mode,                             \
-        .timeoutHandler = timeout_handler,              \
-        .ticksToExpire = 0,                             \
-        .intervalTicks = 0,                             \
-        .nextNode = NULL}
-
-    typedef void (*timeoutHandlerType)(void); // Timeout handler function type definition
+#define TIMER_DEFINE(name, timeout_handler, timer_mode, timer_context) \
+    void timeout_handler(void *);                                      \
+    timerNodeType name = {                                             \
+        .isRunning = false,                                            \
+        .mode = timer_mode,                                            \
+        .timeoutHandler = timeout_handler,                             \
+        .context = timer_context,                                      \
+        .expiryTick = 0,                                               \
+        .intervalTicks = 0,                                            \
+        .nextNode = NULL,                                              \
+        .prevNode = NULL,                                              \
+        .pWheelSlot = NULL,                                            \
+        .nextExpiredNode = NULL,                                       \
+        .pendingCount = 0}
+
+    typedef void (*timeoutHandlerType)(void *context); // Timeout handler function type definition
 
     /*Timer node structure*/
     typedef struct timerNode
     {
         timeoutHandlerType timeoutHandler;
+        void *context;
         uint32_t intervalTicks;
-        uint32_t ticksToExpire;
+        uint32_t expiryTick; // Tick of the timer wheel at which the timer expires
         struct timerNode *nextNode;
+        struct timerNode *prevNode;
+        struct timerNode **pWheelSlot;      // Timer wheel slot holding the timer
+        struct timerNode *nextExpiredNode;  // Links the timer into the queue of expired timers
+        uint32_t pendingCount;              // Number of expiries whose timeout handler is yet to be executed
         timerModeType mode;
         bool isRunning;
+#if (OS_HR_TIMER)
+        hrAlarmType alarm;       // Alarm of the timer started with timerStartUS
+        uint64_t intervalCycles; // Interval of the timer started with timerStartUS
+#endif
 
     } timerNodeType;
 
-    typedef struct timeoutHandlerNode
+    /*Queue of expired timers whose timeout handlers are to be executed by the timer task*/
+    typedef struct
     {
-        timeoutHandlerType timeoutHandler;
-        struct timeoutHandlerNode *nextNode;
+        timerNodeType *head;
+        timerNodeType *tail;
+    } expiredTimerQueueType;
 
-    } timeoutHandlerNodeType;
+#if (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS) > 31
+#error "TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS must not exceed 31"
+#endif
 
-    typedef struct
-    {
-        timeoutHandlerNodeType *head;
-        timeoutHandlerNodeType *tail;
-    } timeoutHandlerQueueType;
+#define TIMER_WHEEL_SLOTS (1UL << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_RANGE (1UL << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) // Number of ticks covered by the timer wheel
 
+    /*Hierarchical timing wheel of running timers. A timer expiring in less than TIMER_WHEEL_SLOTS ticks is kept in
+    the first level, in the slot indexed by the low bits of its expiry tick. Timers expiring later are kept in upper
+    levels, each slot of which covers TIMER_WHEEL_SLOTS times more ticks than a slot of the level below. Whenever the
+    index of a level wraps around, timers of the next slot of the upper level are cascaded down.*/
     typedef struct
     {
-        timerNodeType *head;
-    } timerListType;
+        timerNodeType *slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+        uint32_t currentTick;
+        uint32_t timerCount;
+    } timerWheelType;
 
     int timerStart(timerNodeType *pTimerNode, uint32_t interval);
 
+    int timerStartAt(timerNodeType *pTimerNode, uint64_t firstExpiryTick, uint32_t intervalTicks);
+
+#if (OS_HR_TIMER)
+    int timerStartUS(timerNodeType *pTimerNode, uint32_t intervalUS);
+#endif
+
     int timerStop(timerNodeType *pTimerNode);
 
-    void processTimers();
+    void processTimers(uint32_t elapsedTicks);
+
+    uint32_t timerNextExpiryTicks();
 
     void timerTaskStart();
 
+#if (TASK_STACK_PAINTING)
+    uint32_t timerTaskStackHighWaterMarkGet();
+#endif
+
 #ifdef __cplusplus
 }
 #endif
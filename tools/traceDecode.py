@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright (c) 2024 Surya Poudel
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Convert a dump of the sanoRTOS trace buffer(traceBuffer) to Chrome/Perfetto trace JSON.
+
+Dump the buffer with the debugger, e.g. in gdb:
+
+    dump binary value trace.bin traceBuffer
+
+and convert it, optionally naming kernel objects with the symbols of the firmware:
+
+    arm-none-eabi-nm firmware.elf > symbols.txt
+    tools/traceDecode.py trace.bin -s symbols.txt -o trace.json
+
+The output opens in https://ui.perfetto.dev or chrome://tracing. Each task is shown as a thread running between its
+switch in and switch out events, interrupts are shown on a separate thread and other events are instants.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+TRACE_BUFFER_MAGIC = 0x52544E53
+HEADER_FORMAT = "<IHHIII"  # magic, version, eventSize, eventCount, timestampHz, writeIndex
+EVENT_FORMAT = "<IIHh"  # timestamp, object, eventId, param
+
+# Must match traceEventIdType in trace/trace.h
+TASK_SWITCH_OUT = 1
+TASK_SWITCH_IN = 2
+TASK_BLOCK = 3
+TASK_READY = 4
+TASK_SUSPEND = 5
+MUTEX_LOCK = 6
+MUTEX_UNLOCK = 7
+SEMAPHORE_TAKE = 8
+SEMAPHORE_GIVE = 9
+MSG_QUEUE_SEND = 10
+MSG_QUEUE_RECEIVE = 11
+TIMER_EXPIRY = 12
+ISR_ENTER = 13
+ISR_EXIT = 14
+USER = 15
+
+EVENT_NAMES = {
+    TASK_BLOCK: "block",
+    TASK_READY: "ready",
+    TASK_SUSPEND: "suspend",
+    MUTEX_LOCK: "mutexLock",
+    MUTEX_UNLOCK: "mutexUnlock",
+    SEMAPHORE_TAKE: "semaphoreTake",
+    SEMAPHORE_GIVE: "semaphoreGive",
+    MSG_QUEUE_SEND: "msgQueueSend",
+    MSG_QUEUE_RECEIVE: "msgQueueReceive",
+    TIMER_EXPIRY: "timerExpiry",
+    USER: "user",
+}
+
+# Must match blockedReasonType and wakeupReasonType in task/task.h
+BLOCKED_REASONS = ["NONE", "SLEEP", "WAIT_FOR_SEMAPHORE", "WAIT_FOR_MUTEX", "WAIT_FOR_MSG_QUEUE_DATA",
+                   "WAIT_FOR_MSG_QUEUE_SPACE", "WAIT_FOR_COND_VAR", "WAIT_FOR_TIMER_TIMEOUT", "WAIT_FOR_TASK_EXIT",
+                   "WAIT_FOR_MEM_POOL_BLOCK", "WAIT_FOR_RING_BUFFER_DATA",
+                   "WAIT_FOR_STREAM_DATA", "WAIT_FOR_STREAM_SPACE", "WAIT_FOR_EVENT_FLAGS",
+                   "WAIT_FOR_NOTIFICATION"]
+WAKEUP_REASONS = ["NONE", "WAIT_TIMEOUT", "SLEEP_TIME_TIMEOUT", "SEMAPHORE_TAKEN", "MUTEX_LOCKED",
+                  "MSG_QUEUE_DATA_AVAILABLE", "MSG_QUEUE_SPACE_AVAILABE", "COND_VAR_SIGNALLED", "TIMER_TIMEOUT",
+                  "RESUME", "TASK_EXITED", "MEM_POOL_BLOCK_FREED",
+                  "RING_BUFFER_DATA_AVAILABLE", "STREAM_DATA_AVAILABLE", "STREAM_SPACE_AVAILABLE",
+                  "EVENT_FLAGS_SET", "NOTIFICATION_RECEIVED"]
+
+# Must match retCodes.h
+RET_CODES = {0: "RET_SUCCESS", -1: "RET_INVAL", -2: "RET_TIMEOUT", -3: "RET_EMPTY", -4: "RET_FULL",
+             -5: "RET_NOTASK", -6: "RET_BUSY", -7: "RET_NOTOWNER", -8: "RET_NOTACTIVE", -9: "RET_ALREADYACTIVE",
+             -10: "RET_NOTSUSPENDED", -11: "RET_NOSEM", -12: "RET_NOTLOCKED", -13: "RET_NOMEM"}
+
+# Cortex-M system exceptions, recorded with negative IRQ numbers as in CMSIS
+EXCEPTION_NAMES = {-1: "SysTick", -2: "PendSV", -5: "SVCall"}
+
+PID = 1
+ISR_TID = 0
+
+
+def load_symbols(path):
+    """Map 32-bit addresses of data symbols to their names from nm output."""
+    symbols = {}
+    with open(path) as symbol_file:
+        for line in symbol_file:
+            fields = line.split()
+            if len(fields) == 3 and fields[1] in "bBdDgGsS":
+                symbols[int(fields[0], 16) & 0xFFFFFFFF] = fields[2]
+    return symbols
+
+
+def read_events(data):
+    """Return timestampHz and the events of the buffer, oldest first."""
+    header_size = struct.calcsize(HEADER_FORMAT)
+    magic, version, event_size, event_count, timestamp_hz, write_index = struct.unpack_from(HEADER_FORMAT, data)
+
+    if magic != TRACE_BUFFER_MAGIC:
+        sys.exit("not a sanoRTOS trace buffer: bad magic 0x%08x" % magic)
+    if version != 1:
+        sys.exit("unsupported trace format version %d" % version)
+
+    stored = min(write_index, event_count)
+    events = []
+
+    for index in range(write_index - stored, write_index):
+        offset = header_size + (index % event_count) * event_size
+        events.append(struct.unpack_from(EVENT_FORMAT, data, offset))
+
+    return timestamp_hz, events
+
+
+def decode(data, symbols):
+    timestamp_hz, events = read_events(data)
+
+    if timestamp_hz == 0:
+        sys.exit("timestampHz is 0: trace buffer was dumped before the scheduler started")
+
+    def name(address):
+        return symbols.get(address, "0x%08x" % address)
+
+    trace = [{"ph": "M", "pid": PID, "name": "process_name", "args": {"name": "sanoRTOS"}},
+             {"ph": "M", "pid": PID, "tid": ISR_TID, "name": "thread_name", "args": {"name": "Interrupts"}}]
+    tasks = set()
+
+    # Unwrap 32-bit timestamps. Events are stored in order of recording; a small step backwards happens only if an
+    # interrupt recorded an event between reserving a slot and reading the timestamp.
+    cycles = 0
+    last_timestamp = None
+    running_task = None
+    isr_depth = 0
+
+    for timestamp, address, event_id, param in events:
+        if last_timestamp is not None:
+            delta = (timestamp - last_timestamp) & 0xFFFFFFFF
+            cycles += delta - (1 << 32) if delta >= (1 << 31) else delta
+        last_timestamp = timestamp
+
+        ts = cycles * 1e6 / timestamp_hz
+        event = {"pid": PID, "ts": ts}
+
+        if event_id in (TASK_SWITCH_IN, TASK_SWITCH_OUT):
+            tasks.add(address)
+            event.update(ph="B" if event_id == TASK_SWITCH_IN else "E", tid=address, name=name(address))
+            running_task = address if event_id == TASK_SWITCH_IN else None
+        elif event_id in (ISR_ENTER, ISR_EXIT):
+            event.update(ph="B" if event_id == ISR_ENTER else "E", tid=ISR_TID, name=EXCEPTION_NAMES.get(param, "IRQ %d" % param))
+            isr_depth += 1 if event_id == ISR_ENTER else -1
+        else:
+            event.update(ph="i", s="t", name=EVENT_NAMES.get(event_id, "event %d" % event_id))
+
+            if event_id in (TASK_BLOCK, TASK_READY, TASK_SUSPEND):
+                tasks.add(address)
+                event["tid"] = address
+                if event_id == TASK_BLOCK and 0 <= param < len(BLOCKED_REASONS):
+                    event["args"] = {"reason": BLOCKED_REASONS[param]}
+                elif event_id == TASK_READY and 0 <= param < len(WAKEUP_REASONS):
+                    event["args"] = {"reason": WAKEUP_REASONS[param]}
+            else:
+                event["tid"] = ISR_TID if isr_depth > 0 or running_task is None else running_task
+                event["args"] = {"object": name(address)}
+                if event_id != TIMER_EXPIRY and event_id != USER:
+                    event["args"]["result"] = RET_CODES.get(param, param)
+                elif event_id == USER:
+                    event["args"]["param"] = param
+
+        trace.append(event)
+
+    for address in tasks:
+        trace.append({"ph": "M", "pid": PID, "tid": address, "name": "thread_name", "args": {"name": name(address)}})
+
+    return {"traceEvents": trace, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a sanoRTOS trace buffer dump to Chrome/Perfetto JSON")
+    parser.add_argument("dump", help="binary dump of traceBuffer")
+    parser.add_argument("-s", "--symbols", help="nm output of the firmware, used to name tasks and kernel objects")
+    parser.add_argument("-o", "--output", help="output JSON file[default: stdout]")
+    args = parser.parse_args()
+
+    with open(args.dump, "rb") as dump_file:
+        data = dump_file.read()
+
+    symbols = load_symbols(args.symbols) if args.symbols else {}
+
+    result = decode(data, symbols)
+
+    if args.output:
+        with open(args.output, "w") as output_file:
+            json.dump(result, output_file)
+    else:
+        json.dump(result, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "osConfig.h"
+#include "trace.h"
+
+#if (OS_TRACE)
+
+traceBufferType traceBuffer = {
+    .magic = TRACE_BUFFER_MAGIC,
+    .version = TRACE_FORMAT_VERSION,
+    .eventSize = sizeof(traceEventType),
+    .eventCount = OS_TRACE_BUFFER_EVENTS,
+    .timestampHz = 0,
+    .writeIndex = 0};
+
+#if defined(DWT)
+/**
+ * @brief Read DWT cycle counter, used as the trace timestamp.
+ *
+ * @return Cycle count
+ */
+static inline uint32_t traceTimestampRead()
+{
+    return DWT->CYCCNT;
+}
+#endif
+
+/**
+ * @brief Initialize tracing. Called by the scheduler on start.
+ */
+void traceInit()
+{
+#if defined(DWT)
+    /*Enable DWT cycle counter used as the trace timestamp*/
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+    traceBuffer.timestampHz = SystemCoreClock;
+}
+
+/**
+ * @brief Record an event into the trace ring buffer, overwriting the oldest event once the buffer is full. Slot is
+ * reserved with LDREX/STREX on cores having them; hence, recording is lock-free and callable from any context. On
+ * ARMv6-M, interrupts are masked only while incrementing the write index.
+ *
+ * @param eventId Event
+ * @param pObject Pointer to the kernel object of the event
+ * @param param Event parameter
+ */
+void traceRecord(traceEventIdType eventId, const void *pObject, int32_t param)
+{
+    uint32_t index;
+
+#if defined(__ARM_FEATURE_LDREX) && (__ARM_FEATURE_LDREX & 4)
+    do
+    {
+        index = __LDREXW(&traceBuffer.writeIndex);
+    } while (__STREXW(index + 1, &traceBuffer.writeIndex) != 0);
+#else
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+
+    index = traceBuffer.writeIndex++;
+
+    __set_PRIMASK(primask);
+#endif
+
+    traceEventType *pEvent = &traceBuffer.events[index & (OS_TRACE_BUFFER_EVENTS - 1)];
+
+    pEvent->timestamp = traceTimestampRead();
+    pEvent->object = (uint32_t)(uintptr_t)pObject;
+    pEvent->eventId = (uint16_t)eventId;
+    pEvent->param = (int16_t)param;
+}
+
+/**
+ * @brief Record entry to an interrupt handler. Application interrupt handlers call this to appear in the trace.
+ *
+ * @param irqNumber IRQ number of the interrupt
+ */
+void traceIsrEnter(int32_t irqNumber)
+{
+    traceRecord(TRACE_EVENT_ISR_ENTER, NULL, irqNumber);
+}
+
+/**
+ * @brief Record exit from an interrupt handler.
+ *
+ * @param irqNumber IRQ number of the interrupt
+ */
+void traceIsrExit(int32_t irqNumber)
+{
+    traceRecord(TRACE_EVENT_ISR_EXIT, NULL, irqNumber);
+}
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Surya Poudel
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef __SANO_RTOS_TRACE_H
+#define __SANO_RTOS_TRACE_H
+
+#include <stdint.h>
+#include "osConfig.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TRACE_BUFFER_MAGIC 0x52544e53UL // "SNTR" in little endian
+#define TRACE_FORMAT_VERSION 1
+
+    /*Kernel trace events. Values are part of the trace format decoded by tools/traceDecode.py; append new events only.*/
+    typedef enum
+    {
+        TRACE_EVENT_TASK_SWITCH_OUT = 1, // object: task, param: taskStatusType of the task
+        TRACE_EVENT_TASK_SWITCH_IN,      // object: task
+        TRACE_EVENT_TASK_BLOCK,          // object: task, param: blockedReasonType
+        TRACE_EVENT_TASK_READY,          // object: task, param: wakeupReasonType
+        TRACE_EVENT_TASK_SUSPEND,        // object: task
+        TRACE_EVENT_MUTEX_LOCK,          // object: mutex, param: return code
+        TRACE_EVENT_MUTEX_UNLOCK,        // object: mutex, param: return code
+        TRACE_EVENT_SEMAPHORE_TAKE,      // object: semaphore, param: return code
+        TRACE_EVENT_SEMAPHORE_GIVE,      // object: semaphore, param: return code
+        TRACE_EVENT_MSG_QUEUE_SEND,      // object: msgQueue, param: return code
+        TRACE_EVENT_MSG_QUEUE_RECEIVE,   // object: msgQueue, param: return code
+        TRACE_EVENT_TIMER_EXPIRY,        // object: timer
+        TRACE_EVENT_ISR_ENTER,           // param: IRQ number
+        TRACE_EVENT_ISR_EXIT,            // param: IRQ number
+        TRACE_EVENT_USER                 // object and param defined by the application
+    } traceEventIdType;
+
+    /*Trace event record*/
+    typedef struct
+    {
+        uint32_t timestamp; // Cycle count
+        uint32_t object;    // Address of the kernel object. Truncated to 32 bits on 64-bit hosts.
+        uint16_t eventId;
+        int16_t param;
+    } traceEventType;
+
+    /*Trace ring buffer. It is dumped as a whole, e.g. with the debugger, and decoded on the host. writeIndex counts all
+    events ever recorded; the last OS_TRACE_BUFFER_EVENTS of them are kept.*/
+    typedef struct
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t eventSize;
+        uint32_t eventCount; // Capacity of the buffer in events
+        uint32_t timestampHz;
+        volatile uint32_t writeIndex;
+        traceEventType events[OS_TRACE_BUFFER_EVENTS];
+    } traceBufferType;
+
+#if (OS_TRACE)
+
+#if (OS_TRACE_BUFFER_EVENTS & (OS_TRACE_BUFFER_EVENTS - 1)) != 0
+#error "OS_TRACE_BUFFER_EVENTS must be a power of 2"
+#endif
+
+#if !defined(DWT)
+    extern uint32_t traceTimestampRead(); // Free running 32-bit counter provided by the application on cores without DWT
+#endif
+
+    extern traceBufferType traceBuffer;
+
+    void traceInit();
+
+    void traceRecord(traceEventIdType eventId, const void *pObject, int32_t param);
+
+    void traceIsrEnter(int32_t irqNumber);
+
+    void traceIsrExit(int32_t irqNumber);
+
+/**
+ * @brief Record a trace event. Compiled out unless OS_TRACE is enabled.
+ * @param eventId Event of type traceEventIdType
+ * @param pObject Pointer to the kernel object of the event
+ * @param param Event parameter
+ */
+#define TRACE_EVENT(eventId, pObject, param) traceRecord(eventId, pObject, param)
+
+#else
+
+#define TRACE_EVENT(eventId, pObject, param) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif